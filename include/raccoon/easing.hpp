@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__EASING_HPP
+#define RACCOON__EASING_HPP
+
+#include <cstddef>
+#include "raccoon.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * Time-based easing for a quadratic Bezier curve. The curve's x axis is time and 
+     * its y axis is progress; the x to t inversion is solved in closed form from 
+     * coefficients precomputed on construction.
+     */
+    class RACCOON_API Easing {
+    private:
+        float m_x_a;
+        float m_x_b;
+        float m_y_a;
+        float m_y_b;
+        float m_y_c;
+
+    public:
+        float evaluate(float time) const noexcept;
+        void evaluate(const float *times, float *values, std::size_t count) const noexcept;
+        static Easing linear() noexcept;
+        Easing(float x0, float y0, float x1, float y1, float x2, float y2) noexcept;
+        Easing() noexcept;
+    };
+}
+
+#endif
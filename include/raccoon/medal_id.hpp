@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDAL_ID_HPP
+#define RACCOON__MEDAL_ID_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace Raccoon::Medals {
+    using MedalId = std::uint16_t;
+    constexpr MedalId MEDAL_ID_NONE = 0xFFFF;
+
+    /**
+     * FNV-1a hash of a medal name; built-in medal names are hashed at compile time
+     */
+    constexpr std::uint32_t medal_name_hash(std::string_view name) noexcept {
+        std::uint32_t hash = 2166136261u;
+        for(char c : name) {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
+}
+
+#endif
@@ -8,12 +8,16 @@
 #include <queue>
 #include <deque>
 #include <optional>
+#include <vector>
+#include <array>
 #include <cstdint>
 #include <balltze/events/render.hpp>
 #include <balltze/math.hpp>
 #include <balltze/engine/data_types.hpp>
 #include <balltze/engine/tag_definitions/bitmap.hpp>
 #include "raccoon.hpp"
+#include "easing.hpp"
+#include "medal_id.hpp"
 
 namespace Raccoon::Medals {
 #include <balltze/helpers/event_base.hpp>
@@ -40,63 +44,254 @@ namespace Raccoon::Medals {
         MEDAL_STATE_PROPERTY_ROTATION
     };
 
+    constexpr std::size_t MEDAL_STATE_PROPERTIES_COUNT = MEDAL_STATE_PROPERTY_ROTATION + 1;
+
+    enum MedalCurve {
+        MEDAL_CURVE_LINEAR,
+        MEDAL_CURVE_FLAT
+    };
+
+    struct MedalKeyframeDefinition {
+        MedalStateProperty property;
+        MedalCurve curve;
+        float value;
+        long duration;
+    };
+
+    /**
+     * Checks a keyframes table at compile time: durations can't be negative, 
+     * opacity must be in the 0-1 range and scale must be positive.
+     */
+    template<std::size_t N>
+    constexpr bool validate_medal_keyframes(const std::array<MedalKeyframeDefinition, N> &keyframes) noexcept {
+        for(const auto &keyframe : keyframes) {
+            if(keyframe.duration < 0) {
+                return false;
+            }
+            if(keyframe.property == MEDAL_STATE_PROPERTY_OPACITY && (keyframe.value < 0.0f || keyframe.value > 1.0f)) {
+                return false;
+            }
+            if(keyframe.property == MEDAL_STATE_PROPERTY_SCALE && keyframe.value <= 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct MedalStateBatch;
+
     class RACCOON_API MedalSequence {
+    public:
+        /**
+         * Per-render playback position of a sequence; it holds the current keyframe of 
+         * every track so evaluation resumes where the previous frame left off.
+         */
+        struct Cursor {
+            std::array<std::size_t, MEDAL_STATE_PROPERTIES_COUNT> keyframes = {};
+        };
+
+        /**
+         * Worst-case absolute difference between the baked table and the exact evaluation.
+         * Opacity is measured in color mask units (0-255).
+         */
+        struct BakeError {
+            float position = 0.0f;
+            float scale = 0.0f;
+            float opacity = 0.0f;
+            float rotation = 0.0f;
+        };
+
     private:
         struct Keyframe {
             long duration;
             Math::QuadraticBezier curve;
+            Easing easing;
             union Value {
                 Engine::Point position;
                 float scale;
             } value;
         };
 
+        /**
+         * Flattened keyframes of a single property. Values holds the property value 
+         * before each keyframe starts plus the value after the last one.
+         */
+        struct Track {
+            MedalStateProperty property;
+            std::vector<long> starts;
+            std::vector<long> ends;
+            std::vector<long> durations;
+            std::vector<Easing> easings;
+            std::vector<float> targets;
+            std::vector<float> values;
+            long duration;
+        };
+
+        struct BakedSample {
+            float position_x;
+            float position_y;
+            float scale;
+            float opacity;
+            float rotation;
+        };
+
+        struct BakedTable {
+            long step;
+            long duration;
+            std::vector<BakedSample> samples;
+        };
+
         std::map<MedalStateProperty, std::deque<Keyframe>> m_properties_sequences;
         std::optional<long> m_max_duration_buffer;
+        std::optional<std::vector<Track>> m_tracks_buffer;
+        std::optional<BakedTable> m_baked_table;
+
+        const std::vector<Track> &tracks() noexcept;
 
     public:
         long duration() noexcept;
         void add_property_keyframe(MedalStateProperty property, Math::QuadraticBezier curve, Keyframe::Value value, long duration) noexcept;
         MedalState get_state_at(std::chrono::milliseconds elapsed) noexcept;
+        MedalState get_state_at(std::chrono::milliseconds elapsed, Cursor &cursor) noexcept;
+        void bake(std::chrono::milliseconds step = std::chrono::milliseconds(1)) noexcept;
+        bool baked() const noexcept;
+        MedalState get_baked_state_at(std::chrono::milliseconds elapsed) const noexcept;
+        BakeError measure_bake_error() noexcept;
+        void get_states_at(MedalStateBatch &batch) noexcept;
+
+        /**
+         * Batched version of get_state_at with cursors; used by get_states_at for sequences that aren't baked
+         */
+        void get_exact_states_at(MedalStateBatch &batch) noexcept;
         MedalSequence() = default;
+        MedalSequence(const MedalKeyframeDefinition *keyframes, std::size_t count) noexcept;
+
+        template<std::size_t N>
+        MedalSequence(const std::array<MedalKeyframeDefinition, N> &keyframes) noexcept : MedalSequence(keyframes.data(), N) {}
+    };
+
+    /**
+     * States of several renders of the same sequence, stored as structure of arrays so 
+     * a whole frame can be evaluated in a single vectorizable pass. Opacity is kept in 
+     * color mask units (0-255).
+     */
+    struct RACCOON_API MedalStateBatch {
+        std::vector<std::chrono::milliseconds::rep> elapsed;
+        std::vector<MedalSequence::Cursor *> cursors;
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> scale;
+        std::vector<float> opacity;
+        std::vector<float> rotation;
+        std::vector<std::uint8_t> sequence_finished;
+
+        /** Scratch buffers used while evaluating baked sequences */
+        std::vector<std::size_t> samples_from;
+        std::vector<std::size_t> samples_to;
+        std::vector<float> samples_progress;
+        std::vector<float> values_from;
+        std::vector<float> values_to;
+
+        /** Scratch buffers used while evaluating sequences that aren't baked */
+        std::vector<std::chrono::milliseconds::rep> times;
+        std::vector<MedalSequence::Cursor> scratch_cursors;
+        std::vector<std::size_t> track_keyframes;
+        std::vector<std::size_t> easing_entries;
+        std::vector<float> easing_times;
+        std::vector<float> easing_values;
+
+        std::size_t size() const noexcept;
+        void clear() noexcept;
+        void push(std::chrono::milliseconds elapsed, MedalSequence::Cursor *cursor = nullptr) noexcept;
+        void resize_outputs() noexcept;
+        MedalState state(std::size_t index) const noexcept;
+    };
+
+    /**
+     * Location of a flipbook frame inside the medals atlas, in normalized texture coordinates.
+     */
+    struct MedalAtlasFrame {
+        std::uint16_t page;
+        float left;
+        float top;
+        float right;
+        float bottom;
     };
 
     class RACCOON_API Medal {
     private:
+        MedalId m_id = MEDAL_ID_NONE;
         std::string m_name;
         std::uint16_t m_width;
         std::uint16_t m_height;
         std::uint8_t m_fps;
+        std::uint8_t m_tier = 0;
         std::vector<Engine::TagDefinitions::BitmapData *> m_bitmaps;
+        std::vector<MedalAtlasFrame> m_atlas_frames;
         std::string m_bitmap_tag_path;
         std::optional<std::string> m_sound_tag_path;
         MedalSequence *m_sequence;
 
+        std::size_t get_frame_index_at(std::chrono::milliseconds elapsed) const noexcept;
+
     public:
+        MedalId id() const noexcept;
+        void set_id(MedalId id) noexcept;
         const std::string &name() const noexcept;
         std::uint16_t width() const noexcept;
         std::uint16_t height() const noexcept;
+        std::uint8_t tier() const noexcept;
+        void set_tier(std::uint8_t tier) noexcept;
         std::optional<std::string> sound_tag_path() const noexcept;
         std::string bitmap_tag_path() const noexcept;
         const MedalSequence *sequence() const noexcept;
+        /**
+         * Draw the medal as of the steady clock; callers with their own time source should pass its time instead
+         */
         MedalState draw(Engine::Point2D offset, std::optional<TimePoint> creation_time) const noexcept;
-        void reload_bitmap_tag() noexcept;
+        MedalState draw(Engine::Point2D offset, std::optional<TimePoint> creation_time, MedalSequence::Cursor &cursor) const noexcept;
+
+        /**
+         * Draw the medal as of now; a medal without a creation time is drawn at its first frame
+         */
+        MedalState draw(Engine::Point2D offset, std::optional<TimePoint> creation_time, TimePoint now, MedalSequence::Cursor &cursor) const noexcept;
+        MedalState draw(Engine::Point2D offset, std::chrono::milliseconds elapsed, MedalState state) const noexcept;
+        Engine::TagDefinitions::BitmapData *get_bitmap_at(std::chrono::milliseconds elapsed) const noexcept;
+        const MedalAtlasFrame *get_atlas_frame_at(std::chrono::milliseconds elapsed) const noexcept;
+        const std::vector<Engine::TagDefinitions::BitmapData *> &bitmaps() const noexcept;
+        void set_atlas_frames(std::vector<MedalAtlasFrame> frames) noexcept;
+        Engine::Rectangle2D get_draw_rect(Engine::Point2D offset, const MedalState &state) const noexcept;
+        MedalState get_state_at(std::chrono::milliseconds elapsed, MedalSequence::Cursor &cursor) const noexcept;
+        void get_states_at(MedalStateBatch &batch) const noexcept;
+        /**
+         * Look up the bitmap tag frames again, e.g. after a map load
+         * @param load_textures load the frame textures right away instead of leaving it to load_bitmap_textures
+         */
+        void reload_bitmap_tag(bool load_textures = true) noexcept;
+        void load_bitmap_textures() noexcept;
+        void free_bitmap_textures() noexcept;
+
+        /**
+         * Size of the pixel data of every frame
+         */
+        std::size_t bitmap_bytes() const noexcept;
 
         Medal(std::string name, std::uint16_t width, std::uint16_t height, std::string bitmap_tag_path, std::optional<std::string> sound_tag_path, MedalSequence &sequence) 
           : m_name(name), m_width(width), m_height(height), m_bitmap_tag_path(bitmap_tag_path), m_sound_tag_path(sound_tag_path), m_sequence(&sequence) {
             m_fps = 0;
-            reload_bitmap_tag();
+            reload_bitmap_tag(false);
         }
 
         Medal(std::string name, std::uint16_t width, std::uint16_t height, std::uint8_t fps, std::string bitmap_tag_path, std::optional<std::string> sound_tag_path, MedalSequence &sequence) 
           : m_name(name), m_width(width), m_height(height), m_fps(fps), m_bitmap_tag_path(bitmap_tag_path), m_sound_tag_path(sound_tag_path), m_sequence(&sequence) {
-            reload_bitmap_tag();            
+            reload_bitmap_tag(false);
         }
     };
 
     struct MedalEventContext {
         const Medal *medal;
         const Balltze::Engine::PlayerHandle player;
+        const MedalId medal_id;
     };
 
     class RACCOON_API MedalEvent: public EventData<MedalEvent> {
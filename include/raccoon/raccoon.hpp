@@ -3,7 +3,9 @@
 #ifndef RACCOON_HPP
 #define RACCOON_HPP
 
-#ifdef RACCOON_EXPORTS
+#ifndef _WIN32
+#define RACCOON_API
+#elif defined(RACCOON_EXPORTS)
 #define RACCOON_API __declspec(dllexport)
 #else
 #define RACCOON_API __declspec(dllimport)
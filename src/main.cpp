@@ -44,6 +44,11 @@ BALLTZE_PLUGIN_API void plugin_load() noexcept {
     Raccoon::logger.info("Loaded");
 }
 
+BALLTZE_PLUGIN_API void plugin_unload() noexcept {
+    // Threads can't be joined from DllMain, so stop them while the loader lock is free
+    Raccoon::Medals::shut_down_medals();
+}
+
 WINAPI BOOL DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved) {
     return TRUE;
 }
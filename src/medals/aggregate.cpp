@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "aggregate.hpp"
+
+namespace Raccoon::Medals {
+    MedalAggregator::PlayerTally *MedalAggregator::get_player_tally(MedalPlayer handle) noexcept {
+        if(handle.is_null() || handle.index >= m_players.size()) {
+            return nullptr;
+        }
+        auto &tally = m_players[handle.index];
+        if(tally.handle != handle) {
+            tally = PlayerTally();
+            tally.handle = handle;
+        }
+        return &tally;
+    }
+
+    MedalId MedalAggregator::resolve_medal(std::string_view name) noexcept {
+        for(std::size_t i = 0; i < m_medal_names.size(); i++) {
+            if(m_medal_names[i] == name) {
+                return static_cast<MedalId>(i);
+            }
+        }
+        if(m_medal_names.size() >= max_medals) {
+            return MEDAL_ID_NONE;
+        }
+        m_medal_names.emplace_back(name);
+        return static_cast<MedalId>(m_medal_names.size() - 1);
+    }
+
+    MedalRuleSet &MedalAggregator::rules() noexcept {
+        return m_rules;
+    }
+
+    std::string_view MedalAggregator::medal_name(MedalId id) const noexcept {
+        if(id >= m_medal_names.size()) {
+            return {};
+        }
+        return m_medal_names[id];
+    }
+
+    void MedalAggregator::update(const MedalHudRecord &record) noexcept {
+        // A message shown to several players may come once per recipient; only the copy for the player it is about counts
+        auto subject = record.message == MEDAL_HUD_MESSAGE_SUICIDE ? record.victim : record.causer;
+        if(!record.local_player.is_null() && record.local_player != subject) {
+            return;
+        }
+
+        if(m_messages == 0) {
+            m_first_tick = record.tick;
+        }
+        m_last_tick = record.tick;
+        m_messages++;
+
+        MedalRuleResults results;
+        auto facts = m_dispatcher.dispatch(record, m_rules, results, false);
+        auto *causer = get_player_tally(record.causer);
+        auto *victim = get_player_tally(record.victim);
+        if(victim && (record.message == MEDAL_HUD_MESSAGE_KILL || record.message == MEDAL_HUD_MESSAGE_SUICIDE)) {
+            victim->deaths++;
+        }
+        if(!causer) {
+            return;
+        }
+        if(facts.kill) {
+            causer->kills++;
+        }
+
+        for(std::size_t i = 0; i < results.count; i++) {
+            auto medal = results.medals[i];
+            if(medal < max_medals && causer->medals[medal] < UINT16_MAX) {
+                causer->medals[medal]++;
+            }
+        }
+    }
+
+    void MedalAggregator::start_match() noexcept {
+        m_dispatcher.reset();
+        m_players = {};
+        m_first_tick = 0;
+        m_last_tick = 0;
+        m_messages = 0;
+        m_match++;
+    }
+
+    std::size_t MedalAggregator::messages() const noexcept {
+        return m_messages;
+    }
+
+    const MedalAggregator::PlayerTally &MedalAggregator::player(std::size_t index) const noexcept {
+        return m_players[index];
+    }
+
+    void MedalAggregator::write_summary(std::ostream &stream) const {
+        stream << "# match " << m_match << " ticks " << m_first_tick << "-" << m_last_tick << " messages " << m_messages << "\n";
+        for(std::size_t i = 0; i < m_players.size(); i++) {
+            auto &[handle, kills, deaths, medals] = m_players[i];
+            if(handle.is_null()) {
+                continue;
+            }
+            stream << handle.index << " " << handle.id << " " << kills << " " << deaths;
+            for(std::size_t j = 0; j < m_medal_names.size(); j++) {
+                if(medals[j] > 0) {
+                    stream << " " << m_medal_names[j] << "=" << medals[j];
+                }
+            }
+            stream << "\n";
+        }
+    }
+}
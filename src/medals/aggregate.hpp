@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__AGGREGATE_HPP
+#define RACCOON__MEDALS__AGGREGATE_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "dispatch.hpp"
+#include "rules.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * Evaluates the medal rules for every player in the match and keeps per-player
+     * counters, for servers where there is no local player to show medals to.
+     * All storage is fixed when the rules are compiled; updating does not allocate.
+     */
+    class MedalAggregator {
+    public:
+        static constexpr std::size_t max_medals = 64;
+
+        struct PlayerTally {
+            MedalPlayer handle;
+            std::uint32_t kills = 0;
+            std::uint32_t deaths = 0;
+            std::array<std::uint16_t, max_medals> medals = {};
+        };
+
+    private:
+        MedalRuleSet m_rules;
+        MedalDispatcher m_dispatcher;
+        std::vector<std::string> m_medal_names;
+        std::array<PlayerTally, MedalDispatcher::max_players> m_players;
+        GameTick m_first_tick = 0;
+        GameTick m_last_tick = 0;
+        std::size_t m_messages = 0;
+        std::size_t m_match = 0;
+
+        /**
+         * Get the tally of the player in the handle slot; the slot is reset when another player takes it
+         */
+        PlayerTally *get_player_tally(MedalPlayer handle) noexcept;
+
+    public:
+        /**
+         * Intern a medal name for the rules; medals past max_medals are not counted
+         */
+        MedalId resolve_medal(std::string_view name) noexcept;
+        MedalRuleSet &rules() noexcept;
+        std::string_view medal_name(MedalId id) const noexcept;
+
+        /**
+         * Count a HUD message; copies of it addressed to other players than the one it is about are ignored
+         */
+        void update(const MedalHudRecord &record) noexcept;
+
+        /**
+         * Clear the counters for a new match; the compiled rules are kept
+         */
+        void start_match() noexcept;
+        std::size_t messages() const noexcept;
+        const PlayerTally &player(std::size_t index) const noexcept;
+
+        /**
+         * Write one line per player who took part: index, ID, kills, deaths, then medal=count pairs
+         */
+        void write_summary(std::ostream &stream) const;
+    };
+}
+
+#endif
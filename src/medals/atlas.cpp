@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <limits>
+#include "atlas.hpp"
+
+namespace Raccoon::Medals {
+    AtlasPacker::AtlasPacker(std::uint16_t page_width, std::uint16_t page_height, std::uint16_t padding) noexcept 
+        : m_page_width(page_width), m_page_height(page_height), m_padding(padding) {}
+
+    std::optional<std::uint16_t> AtlasPacker::fit(const std::vector<SkylineNode> &skyline, std::size_t index, std::uint16_t width, std::uint16_t height) const noexcept {
+        auto x = skyline[index].x;
+        if(x + width > m_page_width) {
+            return std::nullopt;
+        }
+
+        // The rectangle rests on the highest node it spans
+        std::uint16_t y = 0;
+        std::uint32_t width_left = width;
+        for(auto i = index; width_left > 0; i++) {
+            y = std::max(y, skyline[i].y);
+            if(y + height > m_page_height) {
+                return std::nullopt;
+            }
+            width_left -= std::min<std::uint32_t>(width_left, skyline[i].width);
+        }
+        return y;
+    }
+
+    std::optional<AtlasRegion> AtlasPacker::insert_into_page(std::size_t page, std::uint16_t width, std::uint16_t height) noexcept {
+        auto &skyline = m_pages[page];
+        std::optional<std::size_t> best_index;
+        std::uint32_t best_top = std::numeric_limits<std::uint32_t>::max();
+        std::uint16_t best_y = 0;
+
+        for(std::size_t i = 0; i < skyline.size(); i++) {
+            auto y = fit(skyline, i, width, height);
+            if(y && *y + height < best_top) {
+                best_index = i;
+                best_top = *y + height;
+                best_y = *y;
+            }
+        }
+
+        if(!best_index) {
+            return std::nullopt;
+        }
+
+        auto index = *best_index;
+        SkylineNode node = { skyline[index].x, static_cast<std::uint16_t>(best_y + height), width };
+        skyline.insert(skyline.begin() + index, node);
+
+        // Trim the nodes now covered by the new one
+        for(auto i = index + 1; i < skyline.size();) {
+            auto &previous = skyline[i - 1];
+            auto &current = skyline[i];
+            auto previous_end = previous.x + previous.width;
+            if(current.x >= previous_end) {
+                break;
+            }
+            auto shrink = previous_end - current.x;
+            if(current.width <= shrink) {
+                skyline.erase(skyline.begin() + i);
+                continue;
+            }
+            current.x += shrink;
+            current.width -= shrink;
+            break;
+        }
+
+        // Merge neighbours at the same height
+        for(std::size_t i = 0; i + 1 < skyline.size();) {
+            if(skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else {
+                i++;
+            }
+        }
+
+        return AtlasRegion { static_cast<std::uint16_t>(page), node.x, best_y, width, height };
+    }
+
+    std::optional<AtlasRegion> AtlasPacker::insert(std::uint16_t width, std::uint16_t height) noexcept {
+        std::uint32_t padded_width = width + m_padding;
+        std::uint32_t padded_height = height + m_padding;
+        if(width == 0 || height == 0 || padded_width > m_page_width || padded_height > m_page_height) {
+            return std::nullopt;
+        }
+
+        std::optional<AtlasRegion> region;
+        for(std::size_t page = 0; page < m_pages.size() && !region; page++) {
+            region = insert_into_page(page, padded_width, padded_height);
+        }
+        if(!region) {
+            m_pages.push_back({ { 0, 0, m_page_width } });
+            region = insert_into_page(m_pages.size() - 1, padded_width, padded_height);
+        }
+
+        region->width = width;
+        region->height = height;
+        m_used_area += static_cast<std::uint64_t>(width) * height;
+        return region;
+    }
+
+    std::size_t AtlasPacker::pages_count() const noexcept {
+        return m_pages.size();
+    }
+
+    std::uint16_t AtlasPacker::page_width() const noexcept {
+        return m_page_width;
+    }
+
+    std::uint16_t AtlasPacker::page_height() const noexcept {
+        return m_page_height;
+    }
+
+    float AtlasPacker::occupancy() const noexcept {
+        if(m_pages.empty()) {
+            return 0.0f;
+        }
+        auto total_area = static_cast<double>(m_page_width) * m_page_height * m_pages.size();
+        return static_cast<float>(m_used_area / total_area);
+    }
+
+    void AtlasPacker::clear() noexcept {
+        m_pages.clear();
+        m_used_area = 0;
+    }
+}
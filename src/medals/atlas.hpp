@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__ATLAS_HPP
+#define RACCOON__MEDALS__ATLAS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Raccoon::Medals {
+    struct AtlasRegion {
+        std::uint16_t page;
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint16_t width;
+        std::uint16_t height;
+    };
+
+    /**
+     * Skyline bottom-left rectangle packer. Rectangles that don't fit in the current 
+     * pages open a new one; rectangles bigger than a page are rejected.
+     */
+    class AtlasPacker {
+    private:
+        struct SkylineNode {
+            std::uint16_t x;
+            std::uint16_t y;
+            std::uint16_t width;
+        };
+
+        std::uint16_t m_page_width;
+        std::uint16_t m_page_height;
+        std::uint16_t m_padding;
+        std::vector<std::vector<SkylineNode>> m_pages;
+        std::uint64_t m_used_area = 0;
+
+        std::optional<std::uint16_t> fit(const std::vector<SkylineNode> &skyline, std::size_t index, std::uint16_t width, std::uint16_t height) const noexcept;
+        std::optional<AtlasRegion> insert_into_page(std::size_t page, std::uint16_t width, std::uint16_t height) noexcept;
+
+    public:
+        std::optional<AtlasRegion> insert(std::uint16_t width, std::uint16_t height) noexcept;
+        std::size_t pages_count() const noexcept;
+        std::uint16_t page_width() const noexcept;
+        std::uint16_t page_height() const noexcept;
+        float occupancy() const noexcept;
+        void clear() noexcept;
+        AtlasPacker(std::uint16_t page_width, std::uint16_t page_height, std::uint16_t padding = 1) noexcept;
+    };
+}
+
+#endif
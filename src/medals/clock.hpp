@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__CLOCK_HPP
+#define RACCOON__MEDALS__CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace Raccoon::Medals {
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using TimeSource = std::function<TimePoint()>;
+
+    /**
+     * Time source shared by the medal queues. Each frame, tick or HUD message reads it 
+     * once and passes the snapshot down, so everything handled together sees the same 
+     * time. Defaults to the steady clock; tests and benchmarks can plug in a fake one.
+     */
+    class Clock {
+    private:
+        TimeSource m_source;
+
+    public:
+        TimePoint now() const noexcept {
+            return m_source ? m_source() : std::chrono::steady_clock::now();
+        }
+
+        void set_source(TimeSource source) noexcept {
+            m_source = std::move(source);
+        }
+    };
+
+    /**
+     * Game ticks counted from the tick events. Gameplay windows are measured in ticks so
+     * they don't depend on frame timing and the same event stream always gives the same result.
+     */
+    using GameTick = std::uint32_t;
+    constexpr GameTick game_ticks_per_second = 30;
+
+    constexpr GameTick milliseconds_to_game_ticks(std::chrono::milliseconds duration) noexcept {
+        return static_cast<GameTick>((duration.count() * game_ticks_per_second + 999) / 1000);
+    }
+
+    inline std::chrono::milliseconds milliseconds_between(TimePoint from, TimePoint to) noexcept {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from);
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "dispatch.hpp"
+
+namespace Raccoon::Medals {
+    MedalDispatcher::PlayerState *MedalDispatcher::get_player_state(MedalPlayer handle) noexcept {
+        if(handle.is_null() || handle.index >= max_players) {
+            return nullptr;
+        }
+        auto &state = m_player_states[handle.index];
+        if(state.handle != handle) {
+            state = PlayerState();
+            state.handle = handle;
+            m_last_medals[handle.index] = MEDAL_ID_NONE;
+        }
+        return &state;
+    }
+
+    MedalRuleFacts MedalDispatcher::update(const MedalHudRecord &record, const MedalRuleSet &rules) noexcept {
+        auto &[tick, message, causer_handle, victim_handle, local_player_handle, causer_team, victim_team, team_game, causer_respawning] = record;
+        auto *causer_state = get_player_state(causer_handle);
+        auto *victim_state = get_player_state(victim_handle);
+        if(causer_state) {
+            m_player_teams[causer_handle.index] = causer_team;
+        }
+        if(victim_state) {
+            m_player_teams[victim_handle.index] = victim_team;
+        }
+
+        MedalRuleFacts facts;
+        switch(message) {
+            case MEDAL_HUD_MESSAGE_KILL: {
+                // Update causer
+                if(causer_state) {
+                    auto &[handle, killing_spree, multikill, recent_kills, last_death] = *causer_state;
+
+                    facts.kill = true;
+
+                    killing_spree++;
+                    facts.killing_spree = killing_spree;
+
+                    if(multikill > 0) {
+                        auto elapsed = tick - recent_kills.back().tick;
+                        if(elapsed < rules.multikill_window() && multikill + 1 <= rules.multikill_cap()) {
+                            multikill++;
+                            facts.multikill = multikill;
+                        }
+                        else {
+                            multikill = 1;
+                        }
+                    }
+                    else {
+                        multikill = 1;
+                    }
+
+                    if(recent_kills.full()) {
+                        recent_kills.pop_front();
+                    }
+                    recent_kills.push_back({ .player = victim_handle, .tick = tick });
+
+                    if(last_death && last_death->player == victim_handle) {
+                        facts.killed_last_killer = true;
+                        facts.dead = causer_respawning;
+                    }
+                }
+
+                // Update victim
+                if(victim_state && victim_state->multikill > 0) {
+                    auto &[handle, killing_spree, multikill, recent_kills, last_death] = *victim_state;
+                    auto last_kill = recent_kills.back();
+
+                    if(team_game && victim_team != causer_team && !last_kill.player.is_null() && last_kill.player.index < max_players) {
+                        if(causer_team == m_player_teams[last_kill.player.index]) {
+                            facts.avenged_teammate = true;
+                            facts.avenge_elapsed = tick - last_kill.tick;
+                        }
+                    }
+
+                    facts.victim_multikill = multikill;
+
+                    // Reset stats
+                    killing_spree = 0;
+                    multikill = 0;
+                    recent_kills.clear();
+                    last_death = { .player = causer_handle, .tick = tick };
+                }
+
+                break;
+            }
+
+            case MEDAL_HUD_MESSAGE_SUICIDE: {
+                if(victim_state) {
+                    auto &[handle, killing_spree, multikill, recent_kills, last_death] = *victim_state;
+                    killing_spree = 0;
+                    multikill = 0;
+                    recent_kills.clear();
+                    last_death = std::nullopt;
+                }
+                break;
+            }
+
+            case MEDAL_HUD_MESSAGE_CTF_SCORE: {
+                facts.flag_capture = true;
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        return facts;
+    }
+
+    MedalRuleFacts MedalDispatcher::dispatch(const MedalHudRecord &record, const MedalRuleSet &rules, MedalRuleResults &results, bool local_only) noexcept {
+        auto facts = update(record, rules);
+        results.count = 0;
+        if(local_only && record.causer != record.local_player) {
+            return facts;
+        }
+
+        auto *last_medal = !record.causer.is_null() && record.causer.index < max_players ? &m_last_medals[record.causer.index] : nullptr;
+        auto rule_facts = facts;
+        rule_facts.kill = facts.kill && (!last_medal || *last_medal != rules.trigger_medal(MEDAL_RULE_TRIGGER_KILL));
+        rules.evaluate(rule_facts, results);
+        if(last_medal && results.count > 0) {
+            *last_medal = results.medals[results.count - 1];
+        }
+        return facts;
+    }
+
+    void MedalDispatcher::reset() noexcept {
+        m_player_states = {};
+        m_player_teams = {};
+        m_last_medals.fill(MEDAL_ID_NONE);
+    }
+
+    MedalDispatcher::MedalDispatcher() noexcept {
+        m_last_medals.fill(MEDAL_ID_NONE);
+    }
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__DISPATCH_HPP
+#define RACCOON__MEDALS__DISPATCH_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "clock.hpp"
+#include "ring_buffer.hpp"
+#include "rules.hpp"
+
+namespace Raccoon::Medals {
+    enum MedalHudMessage : std::uint8_t {
+        MEDAL_HUD_MESSAGE_OTHER,
+        MEDAL_HUD_MESSAGE_KILL,
+        MEDAL_HUD_MESSAGE_SUICIDE,
+        MEDAL_HUD_MESSAGE_CTF_SCORE
+    };
+
+    /**
+     * Engine player handle, split in table index and salt
+     */
+    struct MedalPlayer {
+        std::uint16_t index = 0xFFFF;
+        std::uint16_t id = 0xFFFF;
+
+        bool is_null() const noexcept {
+            return index == 0xFFFF;
+        }
+
+        bool operator==(const MedalPlayer &other) const noexcept {
+            return index == other.index && id == other.id;
+        }
+
+        bool operator!=(const MedalPlayer &other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * Everything medal dispatch needs from a HUD message, captured when it was received
+     */
+    struct MedalHudRecord {
+        GameTick tick;
+        MedalHudMessage message;
+        MedalPlayer causer;
+        MedalPlayer victim;
+        MedalPlayer local_player;
+        std::uint8_t causer_team;
+        std::uint8_t victim_team;
+        bool team_game;
+        bool causer_respawning;
+    };
+
+    /**
+     * Tracks sprees, multi-kills and deaths of every player from the HUD message stream.
+     * It doesn't touch the engine, so recorded streams can be replayed through it offline.
+     */
+    class MedalDispatcher {
+    public:
+        /** The engine never has more players than this */
+        static constexpr std::size_t max_players = 16;
+        static constexpr std::size_t recent_kills_capacity = 4;
+
+    private:
+        struct PlayerKill {
+            MedalPlayer player;
+            GameTick tick;
+        };
+
+        struct PlayerState {
+            MedalPlayer handle;
+            std::uint32_t killing_spree = 0;
+            std::uint32_t multikill = 0;
+            RingBuffer<PlayerKill, recent_kills_capacity> recent_kills;
+            std::optional<PlayerKill> last_death;
+        };
+
+        std::array<PlayerState, max_players> m_player_states;
+        std::array<std::uint8_t, max_players> m_player_teams = {};
+
+        /** Last medal the rules gave each player, so a kill medal isn't given twice in a row */
+        std::array<MedalId, max_players> m_last_medals;
+
+        /**
+         * Get the state of the player in the handle slot; the slot is reset when another player takes it
+         */
+        PlayerState *get_player_state(MedalPlayer handle) noexcept;
+
+    public:
+        /**
+         * Update the players involved in a HUD message
+         * @return what the message means for its causer; the kill fact ignores repeated kill medals
+         */
+        MedalRuleFacts update(const MedalHudRecord &record, const MedalRuleSet &rules) noexcept;
+
+        /**
+         * Update the players involved in a HUD message and evaluate the rules for its causer
+         * @param local_only  leave the results empty unless the causer is the local player
+         * @return the facts from update, before repeated kill medals are filtered out
+         */
+        MedalRuleFacts dispatch(const MedalHudRecord &record, const MedalRuleSet &rules, MedalRuleResults &results, bool local_only) noexcept;
+        void reset() noexcept;
+        MedalDispatcher() noexcept;
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include <raccoon/easing.hpp>
+
+namespace Raccoon::Medals {
+    static constexpr float min_denominator = 1e-6f;
+
+    Easing::Easing(float x0, float y0, float x1, float y1, float x2, float y2) noexcept {
+        // x(t) - x0 = a * t^2 + b * t, normalized so x goes from 0 to 1
+        auto x_range = x2 - x0;
+        if(std::abs(x_range) > min_denominator) {
+            m_x_a = (x0 - 2 * x1 + x2) / x_range;
+            m_x_b = 2 * (x1 - x0) / x_range;
+        }
+        else {
+            // There is no time axis to solve, so use the time as the curve parameter
+            m_x_a = 0.0f;
+            m_x_b = 1.0f;
+        }
+        m_y_a = y0 - 2 * y1 + y2;
+        m_y_b = 2 * (y1 - y0);
+        m_y_c = y0;
+    }
+
+    Easing::Easing() noexcept : Easing(0.0f, 0.0f, 0.5f, 0.5f, 1.0f, 1.0f) {}
+
+    Easing Easing::linear() noexcept {
+        return Easing();
+    }
+
+    float Easing::evaluate(float time) const noexcept {
+        // Stable root of a * t^2 + b * t - x = 0; it degrades to x / b when a is zero
+        auto discriminant = std::max(m_x_b * m_x_b + 4 * m_x_a * time, 0.0f);
+        auto denominator = std::max(m_x_b + std::sqrt(discriminant), min_denominator);
+        auto t = std::clamp(2 * time / denominator, 0.0f, 1.0f);
+        return (m_y_a * t + m_y_b) * t + m_y_c;
+    }
+
+    void Easing::evaluate(const float *times, float *values, std::size_t count) const noexcept {
+        std::size_t i = 0;
+
+#ifdef __SSE__
+        auto x_a = _mm_set1_ps(4 * m_x_a);
+        auto x_b = _mm_set1_ps(m_x_b);
+        auto x_b_squared = _mm_set1_ps(m_x_b * m_x_b);
+        auto y_a = _mm_set1_ps(m_y_a);
+        auto y_b = _mm_set1_ps(m_y_b);
+        auto y_c = _mm_set1_ps(m_y_c);
+        auto zero = _mm_setzero_ps();
+        auto one = _mm_set1_ps(1.0f);
+        auto two = _mm_set1_ps(2.0f);
+        auto min_denom = _mm_set1_ps(min_denominator);
+
+        for(; i + 4 <= count; i += 4) {
+            auto time = _mm_loadu_ps(times + i);
+            auto discriminant = _mm_max_ps(_mm_add_ps(x_b_squared, _mm_mul_ps(x_a, time)), zero);
+            auto denominator = _mm_max_ps(_mm_add_ps(x_b, _mm_sqrt_ps(discriminant)), min_denom);
+            auto t = _mm_div_ps(_mm_mul_ps(two, time), denominator);
+            t = _mm_min_ps(_mm_max_ps(t, zero), one);
+            auto value = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(y_a, t), y_b), t), y_c);
+            _mm_storeu_ps(values + i, value);
+        }
+#endif
+
+        for(; i < count; i++) {
+            values[i] = evaluate(times[i]);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "event_log.hpp"
+#include "little_endian.hpp"
+
+namespace Raccoon::Medals {
+    MedalEventLogRecordData encode_medal_event_record(const MedalEventRecord &record) noexcept {
+        MedalEventLogRecordData data = {};
+        write_u64(&data[0], record.time);
+        write_u32(&data[8], record.tick);
+        write_u32(&data[12], record.medal_hash);
+        write_u16(&data[16], record.player.index);
+        write_u16(&data[18], record.player.id);
+        return data;
+    }
+
+    MedalEventRecord decode_medal_event_record(const MedalEventLogRecordData &data) noexcept {
+        MedalEventRecord record;
+        record.time = read_u64(&data[0]);
+        record.tick = read_u32(&data[8]);
+        record.medal_hash = read_u32(&data[12]);
+        record.player = { read_u16(&data[16]), read_u16(&data[18]) };
+        return record;
+    }
+
+    std::filesystem::path MedalEventLogWriter::file_path(std::size_t index) const noexcept {
+        char name[32];
+        std::snprintf(name, sizeof(name), "medal_events_%04zu.rmev", index);
+        return m_directory / name;
+    }
+
+    bool MedalEventLogWriter::open_next_file() noexcept {
+        m_file.close();
+
+        // Skip the files left by earlier sessions
+        auto index = m_file_index.load() + 1;
+        std::error_code error;
+        while(std::filesystem::exists(file_path(index), error)) {
+            index++;
+        }
+
+        m_file.open(file_path(index), std::ios::binary | std::ios::trunc);
+        if(!m_file) {
+            return false;
+        }
+        m_file_index = index;
+
+        std::array<std::uint8_t, medal_event_log_header_size> header = {};
+        std::copy(medal_event_log_magic.begin(), medal_event_log_magic.end(), header.begin());
+        write_u16(&header[4], medal_event_log_version);
+        write_u16(&header[6], medal_event_log_record_size);
+        m_file.write(reinterpret_cast<const char *>(header.data()), header.size());
+        m_file_size = header.size();
+        return static_cast<bool>(m_file);
+    }
+
+    void MedalEventLogWriter::write_batch(const MedalEventRecord *records, std::size_t count) noexcept {
+        std::array<std::uint8_t, batch_capacity * medal_event_log_record_size> buffer;
+        for(std::size_t i = 0; i < count; i++) {
+            auto data = encode_medal_event_record(records[i]);
+            std::copy(data.begin(), data.end(), buffer.begin() + i * medal_event_log_record_size);
+        }
+
+        auto size = count * medal_event_log_record_size;
+        if(!m_failed && m_file_size + size > m_max_file_size) {
+            m_failed = !open_next_file();
+        }
+        if(m_failed) {
+            m_dropped += count;
+            return;
+        }
+
+        m_file.write(reinterpret_cast<const char *>(buffer.data()), size);
+        m_file.flush();
+        if(!m_file) {
+            m_failed = true;
+            m_dropped += count;
+            return;
+        }
+        m_file_size += size;
+        m_written += count;
+    }
+
+    void MedalEventLogWriter::run() noexcept {
+        std::array<MedalEventRecord, batch_capacity> batch;
+        while(true) {
+            // Read the flag first so the records queued before stopping are still written
+            bool running = m_running.load(std::memory_order_acquire);
+            auto count = m_queue.pop(batch.data(), batch.size());
+            if(count > 0) {
+                write_batch(batch.data(), count);
+                continue;
+            }
+            if(!running) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        m_file.close();
+    }
+
+    bool MedalEventLogWriter::start(const std::filesystem::path &directory, std::uintmax_t max_file_size) noexcept {
+        stop();
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        m_directory = directory;
+        m_max_file_size = std::max<std::uintmax_t>(max_file_size, medal_event_log_header_size + batch_capacity * medal_event_log_record_size);
+        m_file_index = 0;
+        m_dropped = 0;
+        m_written = 0;
+        m_failed = false;
+        if(!open_next_file()) {
+            return false;
+        }
+
+        m_running = true;
+        m_thread = std::thread(&MedalEventLogWriter::run, this);
+        return true;
+    }
+
+    void MedalEventLogWriter::stop() noexcept {
+        m_running.store(false, std::memory_order_release);
+        if(m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    bool MedalEventLogWriter::running() const noexcept {
+        return m_running;
+    }
+
+    void MedalEventLogWriter::log(const MedalEventRecord &record) noexcept {
+        if(!m_running.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if(!m_queue.push(record)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t MedalEventLogWriter::dropped() const noexcept {
+        return m_dropped;
+    }
+
+    std::size_t MedalEventLogWriter::written() const noexcept {
+        return m_written;
+    }
+
+    std::filesystem::path MedalEventLogWriter::current_file() const noexcept {
+        return file_path(m_file_index);
+    }
+
+    MedalEventLogWriter::~MedalEventLogWriter() noexcept {
+        stop();
+    }
+}
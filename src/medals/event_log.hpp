@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__EVENT_LOG_HPP
+#define RACCOON__MEDALS__EVENT_LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "clock.hpp"
+#include "dispatch.hpp"
+#include "spsc_queue.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * Medal event logs are a small header followed by fixed-size little-endian records.
+     * Medals are stored by name hash so logs from different sessions can be compared.
+     */
+    constexpr std::array<char, 4> medal_event_log_magic = { 'R', 'M', 'E', 'V' };
+    constexpr std::uint16_t medal_event_log_version = 1;
+    constexpr std::size_t medal_event_log_header_size = 8;
+    constexpr std::size_t medal_event_log_record_size = 20;
+
+    struct MedalEventRecord {
+        /** Milliseconds since the Unix epoch */
+        std::uint64_t time = 0;
+        GameTick tick = 0;
+        std::uint32_t medal_hash = 0;
+        MedalPlayer player;
+    };
+
+    using MedalEventLogRecordData = std::array<std::uint8_t, medal_event_log_record_size>;
+
+    MedalEventLogRecordData encode_medal_event_record(const MedalEventRecord &record) noexcept;
+    MedalEventRecord decode_medal_event_record(const MedalEventLogRecordData &data) noexcept;
+
+    /**
+     * Writes medal events to disk on a background thread. The game thread only pushes 
+     * records into a lock-free queue; when the queue is full the record is dropped and 
+     * counted instead of waiting for the disk. Files are numbered and roll over once 
+     * they reach the size limit. Stop it before the DLL is unloaded; joining the thread 
+     * from a static destructor runs under the loader lock.
+     */
+    class MedalEventLogWriter {
+    public:
+        static constexpr std::size_t queue_capacity = 1024;
+        static constexpr std::size_t batch_capacity = 256;
+        static constexpr std::uintmax_t default_max_file_size = 4 * 1024 * 1024;
+
+    private:
+        SpscQueue<MedalEventRecord, queue_capacity> m_queue;
+        std::thread m_thread;
+        std::atomic<bool> m_running = false;
+        std::atomic<std::size_t> m_dropped = 0;
+        std::atomic<std::size_t> m_written = 0;
+        std::atomic<bool> m_failed = false;
+        std::atomic<std::size_t> m_file_index = 0;
+
+        /** Only touched by the writer thread while it runs */
+        std::filesystem::path m_directory;
+        std::uintmax_t m_max_file_size = default_max_file_size;
+        std::ofstream m_file;
+        std::uintmax_t m_file_size = 0;
+
+        std::filesystem::path file_path(std::size_t index) const noexcept;
+        bool open_next_file() noexcept;
+        void write_batch(const MedalEventRecord *records, std::size_t count) noexcept;
+        void run() noexcept;
+
+    public:
+        /**
+         * Open the first free log file in the directory and start the writer thread
+         * @return false if the log file can't be created
+         */
+        bool start(const std::filesystem::path &directory, std::uintmax_t max_file_size = default_max_file_size) noexcept;
+
+        /**
+         * Write the queued records and stop the writer thread
+         */
+        void stop() noexcept;
+        bool running() const noexcept;
+
+        /**
+         * Queue a record; called from the game thread only
+         */
+        void log(const MedalEventRecord &record) noexcept;
+
+        /**
+         * Records dropped because the queue was full or the file couldn't be written
+         */
+        std::size_t dropped() const noexcept;
+        std::size_t written() const noexcept;
+        std::filesystem::path current_file() const noexcept;
+
+        MedalEventLogWriter() = default;
+        MedalEventLogWriter(const MedalEventLogWriter &) = delete;
+        MedalEventLogWriter &operator=(const MedalEventLogWriter &) = delete;
+        ~MedalEventLogWriter() noexcept;
+    };
+}
+
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: GPL-3.0-only
 
+#include <cstring>
 #include <balltze/command.hpp>
 #include <balltze/engine/tag_definitions/tag_collection.hpp>
 #include <balltze/engine/tag_definitions/sound.hpp>
@@ -7,94 +8,191 @@
 #include <balltze/features/tags_handling.hpp>
 #include "../resources/resources.hpp"
 #include "../logger.hpp"
+#include "../profiling/counters.hpp"
+#include "../profiling/trace.hpp"
 #include "h4.hpp"
 
 using namespace Balltze;
 
 namespace Raccoon::Medals {
-    void H4RenderQueue::render() noexcept {
-        auto now = std::chrono::steady_clock::now();
-        
+    constexpr SpriteRect h4_viewport = { 0.0f, 0.0f, 640.0f, 480.0f };
+
+    /**
+     * Medals share one layer and glows another above it, so each layer batches by texture. 
+     * Glows are queued in strip order and share a texture, so they keep that order inside 
+     * their layer; a glow can overlap the next medal while it is larger than its slot.
+     */
+    enum H4SpriteLayer : std::uint16_t {
+        H4_SPRITE_LAYER_MEDALS,
+        H4_SPRITE_LAYER_GLOW
+    };
+
+    bool H4RenderQueue::queue_sprite(const Medal *medal, Engine::Point2D offset, std::chrono::milliseconds elapsed, const MedalState &state, std::uint16_t layer) noexcept {
+        auto *bitmap = medal->get_bitmap_at(elapsed);
+        if(!bitmap) {
+            return false;
+        }
+        if(state.sequence_finished || state.color_mask.alpha == 0 || state.scale <= 0.0f) {
+            m_culled_sprites++;
+            return true;
+        }
+        float center_x = state.position.x + offset.x + medal->width() / 2.0f;
+        float center_y = state.position.y + offset.y + medal->height() / 2.0f;
+        m_sprite_transforms.push(center_x, center_y, medal->width(), medal->height(), state.scale, state.rotation);
+        m_frame_sprites.push_back({ bitmap, medal->get_atlas_frame_at(elapsed), state.color_mask, layer });
+        return true;
+    }
+
+    void H4RenderQueue::submit_sprites() noexcept {
+        m_sprite_transforms.transform();
+        for(std::size_t i = 0; i < m_frame_sprites.size(); i++) {
+            auto &[bitmap, atlas_frame, color, layer] = m_frame_sprites[i];
+            auto bounds = sprite_corners_bounds(m_sprite_transforms.corners[i]);
+            auto empty = bounds.right <= bounds.left || bounds.bottom <= bounds.top;
+            auto off_screen = bounds.right <= h4_viewport.left || bounds.left >= h4_viewport.right || bounds.bottom <= h4_viewport.top || bounds.top >= h4_viewport.bottom;
+            if(empty || off_screen) {
+                m_culled_sprites++;
+                continue;
+            }
+
+            SpriteQuad quad;
+            quad.texture = bitmap;
+            quad.blend_mode = SPRITE_BLEND_MODE_ALPHA;
+            quad.layer = layer;
+            if(atlas_frame) {
+                quad.atlas_page = atlas_frame->page;
+                quad.uv = { atlas_frame->left, atlas_frame->top, atlas_frame->right, atlas_frame->bottom };
+            }
+            quad.corners = m_sprite_transforms.corners[i];
+            quad.rect = bounds;
+            quad.color = { color.alpha, color.red, color.green, color.blue };
+            m_sprite_batcher.add(quad);
+        }
+        m_sprite_batcher.flush();
+        m_frame_sprites.clear();
+        m_sprite_transforms.clear();
+    }
+
+    void H4RenderQueue::evaluate_states(TimePoint now) noexcept {
+        m_medal_states.clear();
+        m_glow_states.clear();
+        for(std::size_t i = 0; i < m_renders.size(); i++) {
+            auto &render = m_renders[i];
+            auto elapsed = milliseconds_between(render.creation_time, now);
+            m_medal_states.push(elapsed, &render.medal_cursor);
+            m_glow_states.push(elapsed, &render.glow_cursor);
+        }
+
+        // Every H4 medal shares the same sequence; the odd one out is evaluated on its own while drawing
+        m_renders.front().medal->get_states_at(m_medal_states);
+        if(m_glow_sprite) {
+            m_glow_sprite->get_states_at(m_glow_states);
+        }
+    }
+
+    void H4RenderQueue::update_layout() noexcept {
+        float offset = 0.0f;
+        m_leading_width = 0.0f;
+        for(std::size_t i = 0; i < m_renders.size(); i++) {
+            auto *medal = m_renders[i].medal;
+            m_slot_offsets[i] = offset;
+            offset += medal->width();
+            if(m_renders[i].creation_time == m_renders.front().creation_time) {
+                m_leading_width += medal->width();
+            }
+        }
+        m_layout_size = m_renders.size();
+        m_layout_dirty = false;
+    }
+
+    void H4RenderQueue::render(TimePoint now) noexcept {
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_H4_RENDER);
+        m_last_frame_culled_sprites = m_culled_sprites;
+        m_culled_sprites = 0;
+        drop_stale_medals(now);
+
         if(m_last_pushed_medal) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - *m_last_pushed_medal).count();
+            auto elapsed = milliseconds_between(*m_last_pushed_medal, now).count();
             if(elapsed > m_slide_duration_ms) {
                 m_last_pushed_medal.reset();
             }
         }
         
         for(std::size_t i = m_renders.size(); i < m_max_renders && !m_queue.empty() && !m_last_pushed_medal; i++) {
-            auto &[time, medal] = m_renders.emplace_front(std::make_pair(now, m_queue.front()));
-            m_queue.pop();
+            Profiling::trace_instant(Profiling::TRACE_EVENT_RENDER_QUEUE_POP, m_queue.front().medal->id());
+            m_renders.push_front({ .creation_time = now, .medal = m_queue.front().medal });
+            m_queue.pop_front();
             m_last_pushed_medal = now;
+            m_layout_dirty = true;
         }
 
         if(m_renders.empty()) {
             return;
         }
 
+        if(m_layout_dirty || m_layout_size != m_renders.size()) {
+            update_layout();
+        }
+
+        evaluate_states(now);
+
         Engine::Point2D position = {8, 358};
-        Engine::Point2D offset = {0, 0};
-        Engine::Point2D base_offset = {0, 0};
-        auto it = m_renders.begin();
+        auto *batched_sequence = m_renders.front().medal->sequence();
+        auto renders_count = m_renders.size();
+        std::size_t render_index = 0;
         
-        auto first_medal_time = it->first;
+        auto first_medal_time = m_renders.front().creation_time;
         auto curve = Math::QuadraticBezier::linear();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - first_medal_time).count();
+        auto elapsed = milliseconds_between(first_medal_time, now).count();
         auto progress = curve.get_point(static_cast<float>(elapsed) / m_slide_duration_ms).y;
+        auto sliding = elapsed < m_slide_duration_ms;
         
-        while(it != m_renders.end()) {
-            auto [creation_time, medal] = *it;
-            auto local_offset = offset;
+        for(std::size_t index = 0; index < renders_count; index++) {
+            auto &[creation_time, medal, medal_cursor, glow_cursor] = m_renders[render_index];
+            Engine::Point2D local_offset = { m_slot_offsets[index], 0 };
 
-            if(elapsed < m_slide_duration_ms && creation_time != first_medal_time) {
-                local_offset.x = (base_offset.x * progress) + (offset.x - base_offset.x);
+            if(sliding && creation_time != first_medal_time) {
+                local_offset.x = (m_leading_width * progress) + (m_slot_offsets[index] - m_leading_width);
             }
 
-            auto state = medal->draw(position + local_offset, creation_time);
-            m_glow_sprite->draw(position + local_offset, creation_time);
-            offset.x += medal->width();
-            if(creation_time == first_medal_time) {
-                base_offset.x += medal->width();
+            auto medal_elapsed = milliseconds_between(creation_time, now);
+            auto medal_state = medal->sequence() == batched_sequence ? m_medal_states.state(index) : medal->get_state_at(medal_elapsed, medal_cursor);
+            if(!queue_sprite(medal, position + local_offset, medal_elapsed, medal_state, H4_SPRITE_LAYER_MEDALS)) {
+                medal_state.sequence_finished = true;
+            }
+            if(m_glow_sprite) {
+                queue_sprite(m_glow_sprite, position + local_offset, medal_elapsed, m_glow_states.state(index), H4_SPRITE_LAYER_GLOW);
             }
-            if(state.sequence_finished) {
-                it = m_renders.erase(it);
+            if(medal_state.sequence_finished) {
+                m_renders.erase(render_index);
+                m_layout_dirty = true;
             }
             else {
-                it++;
+                render_index++;
             }
         }
+
+        submit_sprites();
     }
 
     void H4RenderQueue::set_glow_sprite(Medal *medal) noexcept {
         m_glow_sprite = medal;
     }
 
-    std::vector<Medal> get_h4_medals() noexcept {
-        auto linear_curve = Math::QuadraticBezier::linear();
-        auto flat_curve = Math::QuadraticBezier::flat();
-
-        static std::optional<MedalSequence> medals_sequence;
-        if(!medals_sequence) {
-            medals_sequence = std::make_optional<MedalSequence>();
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 2.0 }, 0);
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 2.0 }, 30);
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 1.5 }, 30); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 1.0 }, 30); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 0.2 }, 0);
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 0.2 }, 30); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 0.6 }, 30); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 1.0 }, 30); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 1.0 }, 1700); 
-            medals_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 0.0 }, 300);
-        }
+    std::size_t H4RenderQueue::last_frame_culled_sprites() const noexcept {
+        return m_last_frame_culled_sprites;
+    }
+
+    void H4RenderQueue::set_sprite_backend(SpriteBatchBackend *backend) noexcept {
+        m_sprite_batcher.set_backend(backend ? backend : &m_engine_sprite_backend);
+    }
 
-        static std::optional<MedalSequence> glow_sequence;
-        if(!glow_sequence) {
-            glow_sequence = std::make_optional<MedalSequence>();
-            glow_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 1.3 }, 0);
-            glow_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_SCALE, linear_curve, { .scale = 1.0 }, 150);
-            glow_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, linear_curve, { .scale = 0.65 }, 0);
-            glow_sequence->add_property_keyframe(MEDAL_STATE_PROPERTY_OPACITY, flat_curve, { .scale = 0.0 }, 130);
+    std::vector<Medal> get_h4_medals() noexcept {
+        static MedalSequence medals_sequence(h4_medal_keyframes);
+        static MedalSequence glow_sequence(h4_glow_keyframes);
+        if(!medals_sequence.baked()) {
+            medals_sequence.bake();
+            glow_sequence.bake();
         }
 
         auto *collection_tag = Engine::get_tag(h4_medals_tag_collection, Engine::TAG_CLASS_TAG_COLLECTION);
@@ -104,34 +202,34 @@ namespace Raccoon::Medals {
         }
 
         auto *collection_data = reinterpret_cast<Engine::TagDefinitions::TagCollection *>(collection_tag->data);
-        std::map<std::string, std::pair<std::string, std::optional<std::string>>> medals_data;
-        for(std::size_t i = 0; i < collection_data->tags.count; i++) {
-            auto &tag_ref = collection_data->tags.elements[i].reference;
-            std::string path = tag_ref.path;
-            std::string name = path.substr(path.find_last_of("\\") + 1);
-            medals_data.try_emplace(name, std::make_pair("", std::nullopt));
-            if(tag_ref.tag_class == Engine::TAG_CLASS_BITMAP) {
-                medals_data[name].first = path;
-            }
-            else if(tag_ref.tag_class == Engine::TAG_CLASS_SOUND) {
-                medals_data[name].second = path;
+        auto collection_has_tag = [&](const char *path, Engine::TagClassInt tag_class) {
+            for(std::size_t i = 0; i < collection_data->tags.count; i++) {
+                auto &tag_ref = collection_data->tags.elements[i].reference;
+                if(tag_ref.tag_class == tag_class && std::strcmp(tag_ref.path, path) == 0) {
+                    return true;
+                }
             }
-        }
+            return false;
+        };
 
         std::vector<Medal> medals;
-        for(auto &[name, data] : medals_data) {
-            auto &[bitmap, sound] = data;
-            if(bitmap.empty()) {
+        medals.reserve(h4_medals.size());
+        for(auto &[name, width, height, fps, tier, bitmap, sound] : h4_medals) {
+            if(!collection_has_tag(bitmap, Engine::TAG_CLASS_BITMAP)) {
+                logger.warning("Missing bitmap for H4 medal {}", name);
                 continue;
             }
-            if(name == "glow") {
-                medals.emplace_back(name, 30, 30, bitmap, sound, *glow_sequence);
-            }
-            else {
-                medals.emplace_back(name, 30, 30, 30, bitmap, sound, *medals_sequence);
+
+            std::optional<std::string> sound_tag_path;
+            if(sound && collection_has_tag(sound, Engine::TAG_CLASS_SOUND)) {
+                sound_tag_path = sound;
             }
+
+            auto &sequence = std::strcmp(name, "glow") == 0 ? glow_sequence : medals_sequence;
+            auto &medal = medals.emplace_back(name, width, height, fps, bitmap, sound_tag_path, sequence);
+            medal.set_tier(tier);
         }
 
-        return std::move(medals);
+        return medals;
     }
 }
@@ -3,24 +3,73 @@
 #ifndef RACCOON__MEDALS__H4_MEDALS_HPP
 #define RACCOON__MEDALS__H4_MEDALS_HPP
 
+#include "h4_catalog.hpp"
+#include "transform.hpp"
 #include "queue.hpp"
 
 namespace Raccoon::Medals {
-    constexpr const char *h4_medals_tag_collection = "raccoon\\medals\\h4";
+    constexpr std::array<MedalKeyframeDefinition, 10> h4_medal_keyframes = {{
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 2.0f, 0 },
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 2.0f, 30 },
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 1.5f, 30 },
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 1.0f, 30 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 0.2f, 0 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 0.2f, 30 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 0.6f, 30 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 1.0f, 30 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 1.0f, 1700 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 0.0f, 300 }
+    }};
+
+    constexpr std::array<MedalKeyframeDefinition, 4> h4_glow_keyframes = {{
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 1.3f, 0 },
+        { MEDAL_STATE_PROPERTY_SCALE, MEDAL_CURVE_LINEAR, 1.0f, 150 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_LINEAR, 0.65f, 0 },
+        { MEDAL_STATE_PROPERTY_OPACITY, MEDAL_CURVE_FLAT, 0.0f, 130 }
+    }};
+
+    static_assert(validate_medal_keyframes(h4_medal_keyframes), "Invalid H4 medal keyframes");
+    static_assert(validate_medal_keyframes(h4_glow_keyframes), "Invalid H4 glow keyframes");
 
     class H4RenderQueue : public RenderQueue {
     private:
+        struct FrameSprite {
+            SpriteTexture bitmap;
+            const MedalAtlasFrame *atlas_frame;
+            Engine::ColorARGBInt color;
+            std::uint16_t layer;
+        };
+
         std::optional<TimePoint> m_last_pushed_medal;
         double m_slide_duration_ms = 60;
-        Medal *m_glow_sprite;
-        MedalSequence m_medals_sequence;
-        MedalSequence m_glow_sequence;
+        Medal *m_glow_sprite = nullptr;
+        MedalStateBatch m_medal_states;
+        MedalStateBatch m_glow_states;
+        EngineSpriteBackend m_engine_sprite_backend;
+        SpriteBatcher m_sprite_batcher = SpriteBatcher(&m_engine_sprite_backend);
+        SpriteTransformBatch m_sprite_transforms;
+        std::vector<FrameSprite> m_frame_sprites;
+        std::size_t m_culled_sprites = 0;
+        std::size_t m_last_frame_culled_sprites = 0;
+        std::array<float, max_renders_capacity> m_slot_offsets = {};
+        float m_leading_width = 0.0f;
+        std::size_t m_layout_size = 0;
+        bool m_layout_dirty = true;
 
-        void render() noexcept override;
+        /**
+         * Recompute the strip slot positions; only needed when a medal is added or removed
+         */
+        void update_layout() noexcept;
+        void evaluate_states(TimePoint now) noexcept;
+        bool queue_sprite(const Medal *medal, Engine::Point2D offset, std::chrono::milliseconds elapsed, const MedalState &state, std::uint16_t layer) noexcept;
+        void submit_sprites() noexcept;
+        void render(TimePoint now) noexcept override;
 
     public:
         void set_glow_sprite(Medal *medal) noexcept;
-        H4RenderQueue() : RenderQueue(6) {}
+        void set_sprite_backend(SpriteBatchBackend *backend) noexcept;
+        std::size_t last_frame_culled_sprites() const noexcept;
+        H4RenderQueue(const Clock &clock) : RenderQueue(6, clock) {}
     };
 
     std::vector<Medal> get_h4_medals() noexcept;
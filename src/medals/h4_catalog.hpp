@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__H4_CATALOG_HPP
+#define RACCOON__MEDALS__H4_CATALOG_HPP
+
+#include <array>
+#include <cstdint>
+#include <raccoon/medal_id.hpp>
+#include "rules.hpp"
+
+namespace Raccoon::Medals {
+    constexpr const char *h4_medals_tag_collection = "raccoon\\medals\\h4";
+
+    struct H4MedalDefinition {
+        const char *name;
+        std::uint16_t width;
+        std::uint16_t height;
+        std::uint8_t fps;
+        std::uint8_t tier;
+        const char *bitmap_tag_path;
+        const char *sound_tag_path;
+    };
+
+    constexpr std::array<H4MedalDefinition, 29> h4_medals = {{
+        { "avenger", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\avenger", nullptr },
+        { "comeback_kill", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\comeback_kill", "raccoon\\medals\\h4\\sounds\\comeback_kill" },
+        { "double_kill", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\double_kill", "raccoon\\medals\\h4\\sounds\\double_kill" },
+        { "extermination", 30, 30, 30, 2, "raccoon\\medals\\h4\\images\\extermination", nullptr },
+        { "flag_capture", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\flag_capture", nullptr },
+        { "flag_champion", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\flag_champion", nullptr },
+        { "flag_runner", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\flag_runner", nullptr },
+        { "from_the_grave", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\from_the_grave", nullptr },
+        { "glow", 30, 30, 0, 0, "raccoon\\medals\\h4\\images\\glow", nullptr },
+        { "headshot", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\headshot", nullptr },
+        { "inconceivable", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\inconceivable", "raccoon\\medals\\h4\\sounds\\inconceivable" },
+        { "invincible", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\invincible", nullptr },
+        { "kill", 30, 30, 30, 0, "raccoon\\medals\\h4\\images\\kill", nullptr },
+        { "killimanjaro", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\killimanjaro", "raccoon\\medals\\h4\\sounds\\killimanjaro" },
+        { "killing_frenzy", 30, 30, 30, 3, "raccoon\\medals\\h4\\images\\killing_frenzy", "raccoon\\medals\\h4\\sounds\\killing_frenzy" },
+        { "killing_spree", 30, 30, 30, 2, "raccoon\\medals\\h4\\images\\killing_spree", "raccoon\\medals\\h4\\sounds\\killing_spree" },
+        { "killionaire", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\killionaire", "raccoon\\medals\\h4\\sounds\\killionaire" },
+        { "killjoy", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\killjoy", nullptr },
+        { "killpocalypse", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\killpocalypse", "raccoon\\medals\\h4\\sounds\\killpocalypse" },
+        { "killtacular", 30, 30, 30, 3, "raccoon\\medals\\h4\\images\\killtacular", "raccoon\\medals\\h4\\sounds\\killtacular" },
+        { "killtastrophe", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\killtastrophe", nullptr },
+        { "killtrocity", 30, 30, 30, 3, "raccoon\\medals\\h4\\images\\killtrocity", nullptr },
+        { "overkill", 30, 30, 30, 2, "raccoon\\medals\\h4\\images\\overkill", "raccoon\\medals\\h4\\sounds\\overkill" },
+        { "rampage", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\rampage", "raccoon\\medals\\h4\\sounds\\rampage" },
+        { "revenge", 30, 30, 30, 1, "raccoon\\medals\\h4\\images\\revenge", nullptr },
+        { "running_riot", 30, 30, 30, 3, "raccoon\\medals\\h4\\images\\running_riot", "raccoon\\medals\\h4\\sounds\\running_riot" },
+        { "triple_kill", 30, 30, 30, 2, "raccoon\\medals\\h4\\images\\triple_kill", "raccoon\\medals\\h4\\sounds\\triple_kill" },
+        { "unfriggenbelievable", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\unfriggenbelievable", nullptr },
+        { "untouchable", 30, 30, 30, 4, "raccoon\\medals\\h4\\images\\untouchable", nullptr }
+    }};
+
+    constexpr std::array<MedalRuleDefinition, 23> h4_medal_rules = {{
+        { MEDAL_RULE_TRIGGER_KILL, 0, {}, "kill" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 5, {}, "killing_spree" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 10, {}, "killing_frenzy" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 15, {}, "running_riot" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 20, {}, "rampage" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 25, {}, "untouchable" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 30, {}, "invincible" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 35, {}, "inconceivable" },
+        { MEDAL_RULE_TRIGGER_KILLING_SPREE, 40, {}, "unfriggenbelievable" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 2, std::chrono::milliseconds(4500), "double_kill" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 3, std::chrono::milliseconds(4500), "triple_kill" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 4, std::chrono::milliseconds(4500), "overkill" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 5, std::chrono::milliseconds(4500), "killtacular" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 6, std::chrono::milliseconds(4500), "killtrocity" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 7, std::chrono::milliseconds(4500), "killimanjaro" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 8, std::chrono::milliseconds(4500), "killtastrophe" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 9, std::chrono::milliseconds(4500), "killpocalypse" },
+        { MEDAL_RULE_TRIGGER_MULTIKILL, 10, std::chrono::milliseconds(4500), "killionaire" },
+        { MEDAL_RULE_TRIGGER_FROM_THE_GRAVE, 0, {}, "from_the_grave" },
+        { MEDAL_RULE_TRIGGER_REVENGE, 0, {}, "revenge" },
+        { MEDAL_RULE_TRIGGER_AVENGER, 0, std::chrono::milliseconds(700), "avenger" },
+        { MEDAL_RULE_TRIGGER_KILLJOY, 5, {}, "killjoy" },
+        { MEDAL_RULE_TRIGGER_FLAG_CAPTURE, 0, {}, "flag_capture" }
+    }};
+
+    constexpr bool h4_medal_names_are_unique() noexcept {
+        auto equal = [](const char *a, const char *b) {
+            while(*a && *a == *b) {
+                a++;
+                b++;
+            }
+            return *a == *b;
+        };
+        for(std::size_t i = 0; i < h4_medals.size(); i++) {
+            for(std::size_t j = i + 1; j < h4_medals.size(); j++) {
+                if(equal(h4_medals[i].name, h4_medals[j].name)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    constexpr bool h4_medal_hashes_are_unique() noexcept {
+        for(std::size_t i = 0; i < h4_medals.size(); i++) {
+            for(std::size_t j = i + 1; j < h4_medals.size(); j++) {
+                if(medal_name_hash(h4_medals[i].name) == medal_name_hash(h4_medals[j].name)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(h4_medal_names_are_unique(), "Duplicated H4 medal name");
+    static_assert(h4_medal_hashes_are_unique(), "H4 medal name hashes collide");
+}
+
+#endif
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include "hud_log.hpp"
+#include "little_endian.hpp"
+
+namespace Raccoon::Medals {
+    enum MedalHudLogFlags : std::uint8_t {
+        MEDAL_HUD_LOG_FLAG_TEAM_GAME = 1 << 0,
+        MEDAL_HUD_LOG_FLAG_CAUSER_RESPAWNING = 1 << 1
+    };
+
+    MedalHudLogRecordData encode_medal_hud_record(const MedalHudRecord &record) noexcept {
+        MedalHudLogRecordData data = {};
+        write_u32(&data[0], record.tick);
+        data[4] = record.message;
+        data[5] = (record.team_game ? MEDAL_HUD_LOG_FLAG_TEAM_GAME : 0) | (record.causer_respawning ? MEDAL_HUD_LOG_FLAG_CAUSER_RESPAWNING : 0);
+        data[6] = record.causer_team;
+        data[7] = record.victim_team;
+        write_u16(&data[8], record.causer.index);
+        write_u16(&data[10], record.causer.id);
+        write_u16(&data[12], record.victim.index);
+        write_u16(&data[14], record.victim.id);
+        write_u16(&data[16], record.local_player.index);
+        write_u16(&data[18], record.local_player.id);
+        return data;
+    }
+
+    MedalHudRecord decode_medal_hud_record(const MedalHudLogRecordData &data) noexcept {
+        MedalHudRecord record;
+        record.tick = read_u32(&data[0]);
+        record.message = static_cast<MedalHudMessage>(data[4]);
+        record.team_game = data[5] & MEDAL_HUD_LOG_FLAG_TEAM_GAME;
+        record.causer_respawning = data[5] & MEDAL_HUD_LOG_FLAG_CAUSER_RESPAWNING;
+        record.causer_team = data[6];
+        record.victim_team = data[7];
+        record.causer = { read_u16(&data[8]), read_u16(&data[10]) };
+        record.victim = { read_u16(&data[12]), read_u16(&data[14]) };
+        record.local_player = { read_u16(&data[16]), read_u16(&data[18]) };
+        return record;
+    }
+
+    bool MedalHudLogWriter::open(const std::filesystem::path &path) noexcept {
+        close();
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if(!m_file) {
+            return false;
+        }
+
+        std::array<std::uint8_t, medal_hud_log_header_size> header = {};
+        std::copy(medal_hud_log_magic.begin(), medal_hud_log_magic.end(), header.begin());
+        write_u16(&header[4], medal_hud_log_version);
+        write_u16(&header[6], medal_hud_log_record_size);
+        m_file.write(reinterpret_cast<const char *>(header.data()), header.size());
+        m_records = 0;
+        return static_cast<bool>(m_file);
+    }
+
+    void MedalHudLogWriter::write(const MedalHudRecord &record) noexcept {
+        if(!m_file.is_open()) {
+            return;
+        }
+        auto data = encode_medal_hud_record(record);
+        m_file.write(reinterpret_cast<const char *>(data.data()), data.size());
+        m_records++;
+    }
+
+    void MedalHudLogWriter::close() noexcept {
+        if(m_file.is_open()) {
+            m_file.close();
+        }
+    }
+
+    bool MedalHudLogWriter::is_open() const noexcept {
+        return m_file.is_open();
+    }
+
+    std::size_t MedalHudLogWriter::records() const noexcept {
+        return m_records;
+    }
+
+    bool MedalHudLogReader::open(const std::filesystem::path &path) noexcept {
+        m_file.open(path, std::ios::binary);
+        if(!m_file) {
+            return false;
+        }
+
+        std::array<std::uint8_t, medal_hud_log_header_size> header = {};
+        if(!m_file.read(reinterpret_cast<char *>(header.data()), header.size())) {
+            return false;
+        }
+        return std::equal(medal_hud_log_magic.begin(), medal_hud_log_magic.end(), header.begin())
+            && read_u16(&header[4]) == medal_hud_log_version
+            && read_u16(&header[6]) == medal_hud_log_record_size;
+    }
+
+    bool MedalHudLogReader::read(MedalHudRecord &record) noexcept {
+        MedalHudLogRecordData data;
+        if(!m_file.read(reinterpret_cast<char *>(data.data()), data.size())) {
+            return false;
+        }
+        record = decode_medal_hud_record(data);
+        return true;
+    }
+}
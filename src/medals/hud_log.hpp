@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__HUD_LOG_HPP
+#define RACCOON__MEDALS__HUD_LOG_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include "dispatch.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * HUD message logs are a small header followed by fixed-size little-endian records
+     */
+    constexpr std::array<char, 4> medal_hud_log_magic = { 'R', 'H', 'U', 'D' };
+    constexpr std::uint16_t medal_hud_log_version = 1;
+    constexpr std::size_t medal_hud_log_header_size = 8;
+    constexpr std::size_t medal_hud_log_record_size = 20;
+
+    using MedalHudLogRecordData = std::array<std::uint8_t, medal_hud_log_record_size>;
+
+    MedalHudLogRecordData encode_medal_hud_record(const MedalHudRecord &record) noexcept;
+    MedalHudRecord decode_medal_hud_record(const MedalHudLogRecordData &data) noexcept;
+
+    class MedalHudLogWriter {
+    private:
+        std::ofstream m_file;
+        std::size_t m_records = 0;
+
+    public:
+        bool open(const std::filesystem::path &path) noexcept;
+        void write(const MedalHudRecord &record) noexcept;
+        void close() noexcept;
+        bool is_open() const noexcept;
+        std::size_t records() const noexcept;
+    };
+
+    class MedalHudLogReader {
+    private:
+        std::ifstream m_file;
+
+    public:
+        /**
+         * @return false if the file can't be read or isn't a HUD message log
+         */
+        bool open(const std::filesystem::path &path) noexcept;
+        bool read(MedalHudRecord &record) noexcept;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__LITTLE_ENDIAN_HPP
+#define RACCOON__MEDALS__LITTLE_ENDIAN_HPP
+
+#include <cstdint>
+
+namespace Raccoon::Medals {
+    inline void write_u16(std::uint8_t *data, std::uint16_t value) noexcept {
+        data[0] = value & 0xFF;
+        data[1] = value >> 8;
+    }
+
+    inline void write_u32(std::uint8_t *data, std::uint32_t value) noexcept {
+        write_u16(data, value & 0xFFFF);
+        write_u16(data + 2, value >> 16);
+    }
+
+    inline void write_u64(std::uint8_t *data, std::uint64_t value) noexcept {
+        write_u32(data, value & 0xFFFFFFFF);
+        write_u32(data + 4, value >> 32);
+    }
+
+    inline std::uint16_t read_u16(const std::uint8_t *data) noexcept {
+        return data[0] | (data[1] << 8);
+    }
+
+    inline std::uint32_t read_u32(const std::uint8_t *data) noexcept {
+        return read_u16(data) | (static_cast<std::uint32_t>(read_u16(data + 2)) << 16);
+    }
+
+    inline std::uint64_t read_u64(const std::uint8_t *data) noexcept {
+        return read_u32(data) | (static_cast<std::uint64_t>(read_u32(data + 4)) << 32);
+    }
+}
+
+#endif
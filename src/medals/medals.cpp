@@ -1,11 +1,15 @@
 // SPDX-License-Identifier: GPL-3.0-only
 
 #include <list>
+#include <algorithm>
+#include <fstream>
 #include <balltze/api.hpp>
 #include <balltze/plugin.hpp>
 #include <balltze/command.hpp>
 #include <balltze/config.hpp>
 #include "../logger.hpp"
+#include "../profiling/counters.hpp"
+#include "../profiling/trace.hpp"
 #include "h4.hpp"
 #include "medals.hpp"
 
@@ -15,162 +19,68 @@ namespace Raccoon::Medals {
 
     template class EventHandler<MedalEvent>;
 
-    static double milliseconds_since(std::chrono::steady_clock::time_point time) {
-        auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(now - time).count();
+    static MedalPlayer medal_player(Engine::PlayerHandle handle) noexcept {
+        if(handle.is_null()) {
+            return {};
+        }
+        return { handle.index, handle.id };
     }
-    
-    void MedalsHandler::dispatch_medals(Engine::NetworkGameMultiplayerHudMessage message_type, Engine::PlayerHandle causer_handle, Engine::PlayerHandle victim_handle, Engine::PlayerHandle local_player_handle) noexcept {
-        auto dispatch_medal = [&](std::string name) {
-            if(causer_handle == local_player_handle) {
-                show_medal(name);
-            }
-        };
 
-        auto now = std::chrono::steady_clock::now();
-
-        m_player_states.try_emplace(causer_handle, PlayerState());
-        m_player_states.try_emplace(victim_handle, PlayerState());
+    static Engine::PlayerHandle engine_player(MedalPlayer player) noexcept {
+        if(player.is_null()) {
+            return Engine::PlayerHandle::null();
+        }
+        Engine::PlayerHandle handle;
+        handle.index = player.index;
+        handle.id = player.id;
+        return handle;
+    }
 
+    void MedalsHandler::dispatch_medals(Engine::NetworkGameMultiplayerHudMessage message_type, Engine::PlayerHandle causer_handle, Engine::PlayerHandle victim_handle, Engine::PlayerHandle local_player_handle, GameTick tick) noexcept {
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_DISPATCH_MEDALS);
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_MEDAL_DISPATCH, message_type);
         auto &players_table = Engine::get_player_table();
         auto *causer = players_table.get_player(causer_handle);
         auto *victim = players_table.get_player(victim_handle);
 
+        MedalHudRecord record = {};
+        record.tick = tick;
         switch(message_type) {
-            case Engine::HUD_MESSAGE_LOCAL_KILLED_PLAYER: {
-                // Update causer
-                {
-                    auto &[killing_spree, multikill_spree, last_death] = m_player_states[causer_handle];
-
-                    if(m_last_medal != "kill") {
-                        dispatch_medal("kill");
-                    }
-
-                    killing_spree.push_back({ .player = victim_handle, .timestamp = now });
-
-                    switch(killing_spree.size()) {
-                        case 5:
-                            dispatch_medal("killing_spree");
-                            break;
-                        case 10:
-                            dispatch_medal("killing_frenzy");
-                            break;
-                        case 15:
-                            dispatch_medal("running_riot");
-                            break;
-                        case 20:
-                            dispatch_medal("rampage");
-                            break;
-                        case 25:
-                            dispatch_medal("untouchable");
-                            break;
-                        case 30:
-                            dispatch_medal("invincible");
-                            break;
-                        case 35:
-                            dispatch_medal("inconceivable");
-                            break;
-                        case 40:
-                            dispatch_medal("unfriggenbelievable");
-                            break;
-                    }
-
-                    multikill_spree.push_back({ .player = victim_handle, .timestamp = now });
-
-                    if(multikill_spree.size() > 1) {
-                        auto last_kill = multikill_spree[multikill_spree.size() - 2];
-                        auto elapsed = milliseconds_since(*last_kill.timestamp);
-                        
-                        if(elapsed < 4500 && multikill_spree.size() <= 10) {
-                            switch(multikill_spree.size()) {
-                                case 2:
-                                    dispatch_medal("double_kill");
-                                    break;
-                                case 3:
-                                    dispatch_medal("triple_kill");
-                                    break;
-                                case 4:
-                                    dispatch_medal("overkill");
-                                    break;
-                                case 5:
-                                    dispatch_medal("killtacular");
-                                    break;
-                                case 6:
-                                    dispatch_medal("killtrocity");
-                                    break;
-                                case 7:
-                                    dispatch_medal("killamanjaro");
-                                    break;
-                                case 8:
-                                    dispatch_medal("killtastrophe");
-                                    break;
-                                case 9:
-                                    dispatch_medal("killpocalypse");
-                                    break;
-                                case 10:
-                                    dispatch_medal("killionaire");
-                                    break;
-                            }
-                        }
-                        else {
-                            multikill_spree.erase(multikill_spree.begin(), multikill_spree.end() - 1);                        
-                        }
-                    }
-
-                    if(last_death) {
-                        if(last_death->player == victim_handle && causer->respawn_time > 0) {
-                            dispatch_medal("from_the_grave");
-                        }
-
-                        if(last_death->player == victim_handle && causer->respawn_time == 0) {
-                            dispatch_medal("revenge");
-                        }
-                    }
-                }
-
-                // Update victim
-                {
-                    auto &[killing_spree, multikill_spree, last_death] = m_player_states[victim_handle];
-
-                    if(multikill_spree.size() > 0) {
-                        auto last_kill = multikill_spree.back();
-                        auto elapsed = milliseconds_since(*last_kill.timestamp);
-                    
-                        if(Engine::network_game_current_game_is_team() && victim->team != causer->team) {
-                            auto last_killed_player = players_table.get_player(last_kill.player);
-                            if(causer->team == last_killed_player->team) {
-                                if(elapsed <= 700) {
-                                    dispatch_medal("avenger");
-                                }
-                            }
-                        }
-
-                        if(multikill_spree.size() >= 5) {
-                            dispatch_medal("killjoy");
-                        }
-
-                        // Reset stats
-                        killing_spree.clear();
-                        multikill_spree.clear();
-                        last_death = { .player = causer_handle, .timestamp = now };
-                    }
-                }
-
+            case Engine::HUD_MESSAGE_LOCAL_KILLED_PLAYER:
+                record.message = MEDAL_HUD_MESSAGE_KILL;
                 break;
-            }
-
-            case Engine::HUD_MESSAGE_SUICIDE: {
-                auto &[killing_spree, multikill_spree, last_death] = m_player_states[victim_handle];
-                killing_spree.clear();
-                multikill_spree.clear();
-                last_death = std::nullopt;
+            case Engine::HUD_MESSAGE_SUICIDE:
+                record.message = MEDAL_HUD_MESSAGE_SUICIDE;
                 break;
-            }
-
-            case Engine::HUD_MESSAGE_LOCAL_CTF_SCORE: {
-                dispatch_medal("flag_capture");
+            case Engine::HUD_MESSAGE_LOCAL_CTF_SCORE:
+                record.message = MEDAL_HUD_MESSAGE_CTF_SCORE;
+                break;
+            default:
+                record.message = MEDAL_HUD_MESSAGE_OTHER;
                 break;
-            }
+        }
+        record.causer = medal_player(causer_handle);
+        record.victim = medal_player(victim_handle);
+        record.local_player = medal_player(local_player_handle);
+        record.causer_team = causer ? causer->team : 0;
+        record.victim_team = victim ? victim->team : 0;
+        record.team_game = Engine::network_game_current_game_is_team();
+        record.causer_respawning = causer && causer->respawn_time > 0;
+
+        m_hud_log.write(record);
+        dispatch_medals(record);
+    }
+
+    void MedalsHandler::dispatch_medals(const MedalHudRecord &record) noexcept {
+        if(m_aggregate) {
+            m_aggregator.update(record);
+            return;
+        }
+
+        MedalRuleResults results;
+        m_dispatcher.dispatch(record, m_rules, results, true);
+        for(std::size_t i = 0; i < results.count; i++) {
+            show_medal(results.medals[i], engine_player(record.causer));
         }
     }
 
@@ -201,23 +111,100 @@ namespace Raccoon::Medals {
     }
 
     void MedalsHandler::update_medals_tag_references() noexcept {
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_UPDATE_MEDALS_TAG_REFERENCES);
         logger.debug("Updating medals tag references...");
         for(auto &medal : m_medals) {
-            medal.reload_bitmap_tag();
+            medal.reload_bitmap_tag(false);
+        }
+#ifdef RACCOON_MEDALS_ATLAS
+        // Only worth it once a sprite backend can draw from atlas pages; the engine one binds every frame's bitmap
+        pack_medals_atlas();
+#endif
+        m_texture_residency.reset();
+        m_sound_queue.resolve_sounds();
+    }
+
+    void MedalsHandler::pack_medals_atlas() noexcept {
+        struct AtlasEntry {
+            std::size_t medal;
+            std::size_t frame;
+            Engine::TagDefinitions::BitmapData *bitmap;
+        };
+
+        std::vector<AtlasEntry> entries;
+        for(std::size_t i = 0; i < m_medals.size(); i++) {
+            auto &bitmaps = m_medals[i].bitmaps();
+            for(std::size_t j = 0; j < bitmaps.size(); j++) {
+                entries.push_back({ i, j, bitmaps[j] });
+            }
+        }
+
+        // Taller frames first packs the skyline tighter
+        std::stable_sort(entries.begin(), entries.end(), [](const AtlasEntry &a, const AtlasEntry &b) {
+            return a.bitmap->height > b.bitmap->height;
+        });
+
+        m_atlas_packer.clear();
+        std::vector<std::vector<MedalAtlasFrame>> frames(m_medals.size());
+        std::vector<bool> packed(m_medals.size(), true);
+        for(std::size_t i = 0; i < m_medals.size(); i++) {
+            frames[i].resize(m_medals[i].bitmaps().size());
+        }
+
+        float page_width = m_atlas_packer.page_width();
+        float page_height = m_atlas_packer.page_height();
+        for(auto &[medal, frame, bitmap] : entries) {
+            auto region = m_atlas_packer.insert(bitmap->width, bitmap->height);
+            if(!region) {
+                packed[medal] = false;
+                continue;
+            }
+            frames[medal][frame] = {
+                region->page,
+                region->x / page_width,
+                region->y / page_height,
+                (region->x + region->width) / page_width,
+                (region->y + region->height) / page_height
+            };
         }
+
+        for(std::size_t i = 0; i < m_medals.size(); i++) {
+            m_medals[i].set_atlas_frames(packed[i] ? std::move(frames[i]) : std::vector<MedalAtlasFrame>());
+        }
+
+        logger.debug("Packed {} medal frames into {} atlas pages ({}% used)", entries.size(), m_atlas_packer.pages_count(), static_cast<int>(m_atlas_packer.occupancy() * 100));
     }
 
     void MedalsHandler::set_up_event_listeners() noexcept {
         m_map_load_event_listener = Event::MapLoadEvent::subscribe([this](auto &event) {
-            if(event.time == Event::EVENT_TIME_AFTER) {
+            if(m_aggregate) {
+                // Loading the next map is the end of the last match
+                if(event.time == Event::EVENT_TIME_BEFORE) {
+                    write_match_summary();
+                    m_aggregator.start_match();
+                }
+                return;
+            }
+            // The bitmaps of the resident medals go away with the map
+            if(event.time == Event::EVENT_TIME_BEFORE) {
+                m_texture_residency.release();
+            }
+            else {
                 update_medals_tag_references();
             }
         });
 
+        m_tick_event_listener = Event::TickEvent::subscribe_const([this](const auto &event) {
+            if(event.time == Event::EVENT_TIME_BEFORE) {
+                m_tick++;
+                m_texture_residency.prefetch(m_tick);
+            }
+        });
+
         m_handle_multiplayer_events_listener = Event::NetworkGameHudMessageEvent::subscribe([this](auto &event) {
             if(event.time == Event::EVENT_TIME_BEFORE) {
                 auto &[message_type, causer, victim, local_player] = event.context;
-                dispatch_medals(message_type, causer, victim, local_player);
+                dispatch_medals(message_type, causer, victim, local_player, m_tick);
                 if(mute_hud_message(message_type)) {
                     event.cancel();
                 }
@@ -233,20 +220,34 @@ namespace Raccoon::Medals {
         });
     }
 
-    Medal *MedalsHandler::get_medal(std::string name) noexcept {
-        for(auto &medal : m_medals) {
-            if(medal.name() == name) {
-                return &medal;
+    Medal *MedalsHandler::get_medal(MedalId id) noexcept {
+        return m_medals.get(id);
+    }
+
+    Medal *MedalsHandler::get_medal(std::string_view name) noexcept {
+        return m_medals.get(m_medals.find(name));
+    }
+
+    MedalId MedalsHandler::add_medal(Medal medal) noexcept {
+        auto sound_tag_path = medal.sound_tag_path();
+        auto id = m_medals.add(std::move(medal));
+        if(id != MEDAL_ID_NONE) {
+            if(m_medal_sounds.size() <= id) {
+                m_medal_sounds.resize(id + 1, { SOUND_ID_NONE, {} });
             }
+            m_medal_sounds[id].first = sound_tag_path ? m_sound_queue.add_sound(std::move(*sound_tag_path)) : SOUND_ID_NONE;
         }
-        return nullptr;
+        return id;
     }
 
-    void MedalsHandler::add_medal(Medal medal) noexcept {
-        m_medals.push_back(medal);
+    void MedalsHandler::show_medal(MedalId id, std::optional<Engine::PlayerHandle> player) noexcept {
+        auto *medal = get_medal(id);
+        if(medal) {
+            show_medal(medal, player);
+        }
     }
 
-    void MedalsHandler::show_medal(std::string name, std::optional<Engine::PlayerHandle> player) noexcept {
+    void MedalsHandler::show_medal(std::string_view name, std::optional<Engine::PlayerHandle> player) noexcept {
         auto *medal = get_medal(name);
         if(medal) {
             show_medal(medal, player);
@@ -254,19 +255,39 @@ namespace Raccoon::Medals {
     }
 
     void MedalsHandler::show_medal(Medal *medal, std::optional<Engine::PlayerHandle> player) {
-        m_last_medal = medal->name();
+        m_texture_residency.use(medal->id(), m_tick);
+        if(m_glow_medal != MEDAL_ID_NONE) {
+            m_texture_residency.use(m_glow_medal, m_tick);
+        }
 
-        MedalEventContext context = { .medal = medal, .player = player.value_or(Engine::PlayerHandle::null()) };
+        MedalEventContext context = { .medal = medal, .player = player.value_or(Engine::PlayerHandle::null()), .medal_id = medal->id() };
         MedalEvent event(EVENT_TIME_BEFORE, context);
         event.dispatch();
 
+        if(m_event_log.running()) {
+            auto now = std::chrono::system_clock::now().time_since_epoch();
+            m_event_log.log({
+                .time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()),
+                .tick = m_tick,
+                .medal_hash = medal_name_hash(medal->name()),
+                .player = medal_player(context.player)
+            });
+            auto dropped = m_event_log.dropped();
+            if(dropped > m_event_log_reported_drops) {
+                logger.warning("Medal event log fell behind; {} events dropped so far", dropped);
+                m_event_log_reported_drops = dropped;
+            }
+        }
+
         if(m_render_queue) {
             m_render_queue->show_medal(medal);
         }
 
-        auto sound = medal->sound_tag_path();
-        if(sound) {
-            m_sound_queue.enqueue_sound(*sound);
+        if(medal->id() < m_medal_sounds.size()) {
+            auto &[sound, scheduling] = m_medal_sounds[medal->id()];
+            if(sound != SOUND_ID_NONE) {
+                m_sound_queue.enqueue_sound(sound, scheduling);
+            }
         }
 
         MedalEvent after_event(EVENT_TIME_AFTER, context);
@@ -282,20 +303,93 @@ namespace Raccoon::Medals {
         load_style();
     }
 
+    void MedalsHandler::set_time_source(TimeSource source) noexcept {
+        m_clock.set_source(std::move(source));
+    }
+
+    bool MedalsHandler::record_hud_messages(const std::filesystem::path &path) noexcept {
+        if(path.empty()) {
+            logger.info("Stopped recording HUD messages ({} recorded)", m_hud_log.records());
+            m_hud_log.close();
+            return true;
+        }
+        if(!m_hud_log.open(path)) {
+            logger.error("Failed to open {} for recording HUD messages", path.string());
+            return false;
+        }
+        logger.info("Recording HUD messages to {}", path.string());
+        return true;
+    }
+
+    bool MedalsHandler::log_medal_events(const std::filesystem::path &directory) noexcept {
+        if(directory.empty()) {
+            m_event_log.stop();
+            logger.info("Stopped logging medal events ({} written, {} dropped)", m_event_log.written(), m_event_log.dropped());
+            return true;
+        }
+        if(!m_event_log.start(directory)) {
+            logger.error("Failed to open a medal event log in {}", directory.string());
+            return false;
+        }
+        m_event_log_reported_drops = 0;
+        logger.info("Logging medal events to {}", m_event_log.current_file().string());
+        return true;
+    }
+
+    void MedalsHandler::print_medal_event_log_status() const noexcept {
+        if(!m_event_log.running()) {
+            logger.info("Medal events are not being logged");
+            return;
+        }
+        logger.info("Logging medal events to {} ({} written, {} dropped)", m_event_log.current_file().string(), m_event_log.written(), m_event_log.dropped());
+    }
+
+    void MedalsHandler::write_match_summary() noexcept {
+        if(m_aggregator.messages() == 0) {
+            return;
+        }
+        auto summary_path = Balltze::get_plugin_path() / "medal_summaries.txt";
+        std::ofstream summary_file(summary_path, std::ios::app);
+        if(!summary_file) {
+            logger.error("Failed to open {} for writing the medal summary", summary_path.string());
+            return;
+        }
+        m_aggregator.write_summary(summary_file);
+        logger.info("Wrote medal summary of {} HUD messages to {}", m_aggregator.messages(), summary_path.string());
+    }
+
+    void MedalsHandler::compile_aggregator_rules() noexcept {
+        compile_rules(m_aggregator.rules(), [this](std::string_view name) {
+            return m_aggregator.resolve_medal(name);
+        });
+    }
+
+    void MedalsHandler::aggregate_medals() noexcept {
+        logger.info("Counting medals for all players");
+        m_aggregate = true;
+        compile_aggregator_rules();
+    }
+
     void MedalsHandler::load_style() noexcept {
-        if(Balltze::get_balltze_side() == Balltze::BALLTZE_SIDE_DEDICATED_SERVER) {
+        // Nothing is shown while aggregating; the style only picks the default rules
+        if(m_aggregate) {
+            compile_aggregator_rules();
             return;
         }
 
+        // Replaced medals take their bitmaps with them
+        m_texture_residency.release();
+
         switch(m_style) {
             case STYLE_H4: {
                 logger.info("Loading H4 medals style...");
-                m_render_queue = std::make_unique<H4RenderQueue>();
+                m_render_queue = std::make_unique<H4RenderQueue>(m_clock);
                 auto medals = get_h4_medals();
                 for(auto &medal : medals) {
                     add_medal(medal);
                 }
-                auto glow = get_medal("glow");
+                m_glow_medal = m_medals.find(medal_name_hash("glow"));
+                auto glow = get_medal(m_glow_medal);
                 if(glow) {
                     static_cast<H4RenderQueue *>(m_render_queue.get())->set_glow_sprite(glow);
                 }
@@ -308,21 +402,89 @@ namespace Raccoon::Medals {
             }
         }
 
+        compile_rules(m_rules, [this](std::string_view name) {
+            return m_medals.find(name);
+        });
+        update_medal_sounds_scheduling();
         update_medals_tag_references();
     }
 
+    void MedalsHandler::compile_rules(MedalRuleSet &rules, const MedalNameResolver &resolve_medal) noexcept {
+        auto rules_path = Balltze::get_plugin_path() / "medal_rules.txt";
+        std::ifstream rules_file(rules_path);
+        if(rules_file) {
+            logger.info("Loading medal rules from {}", rules_path.string());
+            if(!rules.load(rules_file, resolve_medal)) {
+                logger.warning("Some medal rules could not be loaded");
+            }
+            return;
+        }
+
+        switch(m_style) {
+            case STYLE_H4:
+                rules.compile(h4_medal_rules, resolve_medal);
+                break;
+            default:
+                rules.clear();
+                break;
+        }
+    }
+
+    void MedalsHandler::update_medal_sounds_scheduling() noexcept {
+        // Bigger medals are announced first, and a queued spree or multi-kill call gives way to the next one
+        for(std::size_t i = 0; i < m_medal_sounds.size() && i < m_medals.size(); i++) {
+            auto &scheduling = m_medal_sounds[i].second;
+            scheduling = { .priority = m_medals[i].tier() };
+            auto rule = m_rules.find_medal_rule(static_cast<MedalId>(i));
+            if(rule && (rule->trigger == MEDAL_RULE_TRIGGER_KILLING_SPREE || rule->trigger == MEDAL_RULE_TRIGGER_MULTIKILL)) {
+                scheduling.supersede_group = rule->trigger + 1;
+                scheduling.supersede_rank = rule->threshold;
+            }
+        }
+    }
+
+    const SoundQueueStats &MedalsHandler::sound_queue_stats() const noexcept {
+        return m_sound_queue.stats();
+    }
+
+    const TextureResidencyStats &MedalsHandler::texture_residency_stats() const noexcept {
+        return m_texture_residency.stats();
+    }
+
+    void MedalsHandler::set_texture_residency_policy(const TextureResidencyPolicy &policy) noexcept {
+        m_texture_residency.set_policy(policy);
+    }
+
+    void MedalsHandler::shut_down() noexcept {
+        if(m_event_log.running()) {
+            m_event_log.stop();
+        }
+        m_hud_log.close();
+    }
+
     MedalsHandler::MedalsHandler() noexcept {
         set_up_event_listeners();
     }
 
     MedalsHandler::~MedalsHandler() noexcept {
         m_map_load_event_listener.remove();
+        m_tick_event_listener.remove();
         m_handle_multiplayer_events_listener.remove();
         m_multiplayer_sound_event_listener.remove();
     }
 
+    /** The handler lives until static destruction, which is too late to stop its threads */
+    static MedalsHandler *medals_handler = nullptr;
+
     void set_up_medals() {
         static MedalsHandler medals;
+        medals_handler = &medals;
+        static std::size_t max_texture_bytes = TextureResidencyPolicy().max_bytes;
+
+        // Servers have no medals style setting to wait for
+        if(Balltze::get_balltze_side() == Balltze::BALLTZE_SIDE_DEDICATED_SERVER) {
+            medals.aggregate_medals();
+        }
 
         Balltze::register_command("medals_style", "medals", "Sets the medals style.", "[style: string]", +[](int argc, const char **argv) -> bool {
             auto string_for_style = [](MedalsStyle style) {
@@ -347,13 +509,101 @@ namespace Raccoon::Medals {
             return true;
         }, true, 0, 1); 
 
+#ifdef RACCOON_PROFILING
+        Balltze::register_command("raccoon_perf", "medals", "Prints the p50, p99 and max time of each instrumented section since the last call, then resets them.", {}, +[](int, const char **) -> bool {
+            for(std::size_t i = 0; i < Profiling::PROFILE_SECTION_COUNT; i++) {
+                auto section = static_cast<Profiling::ProfileSection>(i);
+                auto &histogram = Profiling::profile_histogram(section);
+                auto microseconds = [](std::uint64_t nanoseconds) {
+                    return nanoseconds / 1000.0;
+                };
+                logger.info("{}: {} calls, p50 {} us, p99 {} us, max {} us", Profiling::profile_section_name(section), histogram.count(), microseconds(histogram.percentile(50)), microseconds(histogram.percentile(99)), microseconds(histogram.max()));
+            }
+            Profiling::reset_profile_histograms();
+            return true;
+        }, false, 0, 0);
+#endif
+
+        Balltze::register_command("raccoon_trace_dump", "medals", "Writes the last seconds of the trace recorder to a Chrome trace_event JSON file in the plugin directory.", "<seconds: float> [file: string]", +[](int argc, const char **argv) -> bool {
+            auto seconds = std::strtod(argv[0], nullptr);
+            if(seconds <= 0) {
+                logger.error("Invalid trace duration {}", argv[0]);
+                return false;
+            }
+            auto path = Balltze::get_plugin_path() / (argc > 1 ? argv[1] : "raccoon_trace.json");
+            std::ofstream file(path);
+            if(!file) {
+                logger.error("Failed to open {} for writing the trace", path.string());
+                return false;
+            }
+            auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+            auto records = Profiling::trace_recorder().write_chrome_trace(file, window);
+            logger.info("Wrote {} trace records to {}", records, path.string());
+            return true;
+        }, false, 1, 2);
+
+        Balltze::register_command("medals_record_hud_messages", "medals", "Records the HUD messages handled by the medals to a file in the plugin directory, or stops recording.", "[file: string]", +[](int argc, const char **argv) -> bool {
+            if(argc == 0) {
+                return medals.record_hud_messages({});
+            }
+            return medals.record_hud_messages(Balltze::get_plugin_path() / argv[0]);
+        }, false, 0, 1);
+
+        Balltze::register_command("medals_log_events", "medals", "Logs the medals shown to files in a directory in the plugin directory, stops logging with \"off\", or prints the log status.", "[directory: string]", +[](int argc, const char **argv) -> bool {
+            if(argc == 0) {
+                medals.print_medal_event_log_status();
+                return true;
+            }
+            if(std::string(argv[0]) == "off") {
+                return medals.log_medal_events({});
+            }
+            return medals.log_medal_events(Balltze::get_plugin_path() / argv[0]);
+        }, false, 0, 1);
+
+        Balltze::register_command("medals_sound_stats", "medals", "Prints how many announcer sounds were played, superseded, skipped for being late, dropped or rejected, and how long they waited.", {}, +[](int, const char **) -> bool {
+            auto &[played, superseded, expired, overflowed, rejected, last_delay, max_delay, total_delay] = medals.sound_queue_stats();
+            auto average_delay = played > 0 ? total_delay.count() / static_cast<std::int64_t>(played) : 0;
+            logger.info("{} sounds played, {} superseded, {} too late, {} dropped, {} rejected", played, superseded, expired, overflowed, rejected);
+            logger.info("Queue delay: last {} ms, average {} ms, max {} ms", last_delay.count(), average_delay, max_delay.count());
+            return true;
+        }, false, 0, 0);
+
+        Balltze::register_command("medals_textures", "medals", "Sets the memory cap for medal textures in MiB and prints how many medals and bytes are resident.", "[max size: int]", +[](int argc, const char **argv) -> bool {
+            if(argc == 1) {
+                int megabytes = 0;
+                try {
+                    megabytes = std::stoi(argv[0]);
+                }
+                catch(...) {}
+                if(megabytes <= 0) {
+                    logger.error("Invalid medal textures memory cap {}", argv[0]);
+                    return false;
+                }
+                max_texture_bytes = static_cast<std::size_t>(megabytes) * 1024 * 1024;
+                medals.set_texture_residency_policy({ .max_bytes = max_texture_bytes });
+            }
+            auto &[resident_medals, resident_bytes, loads, prefetches, evictions] = medals.texture_residency_stats();
+            logger.info("{} medals resident in {} KiB of {} KiB; {} loads ({} prefetched), {} evictions", resident_medals, resident_bytes / 1024, max_texture_bytes / 1024, loads, prefetches, evictions);
+            return true;
+        }, true, 0, 1);
+
         Balltze::register_command("show_medals", "medals", "", {}, +[](int argc, const char **argv) -> bool {
-            std::string name = argv[0];
+            auto *medal = medals.get_medal(argv[0]);
+            if(!medal) {
+                logger.error("Unknown medal {}", argv[0]);
+                return false;
+            }
             int amount = std::stoi(argv[1]);
             for(int i = 0; i < amount; i++) {
-                medals.show_medal(name);
+                medals.show_medal(medal);
             }
             return true;
         }, false, 2, 2, true, false);    
     }
+
+    void shut_down_medals() noexcept {
+        if(medals_handler) {
+            medals_handler->shut_down();
+        }
+    }
 }
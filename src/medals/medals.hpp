@@ -3,7 +3,15 @@
 #ifndef RACCOON__MEDALS__MEDALS_HPP
 #define RACCOON__MEDALS__MEDALS_HPP
 
+#include "aggregate.hpp"
+#include "atlas.hpp"
 #include "queue.hpp"
+#include "dispatch.hpp"
+#include "event_log.hpp"
+#include "hud_log.hpp"
+#include "registry.hpp"
+#include "residency.hpp"
+#include "rules.hpp"
 
 namespace Raccoon::Medals {
     enum MedalsStyle {
@@ -12,48 +20,85 @@ namespace Raccoon::Medals {
 
     class MedalsHandler {
     private:
-        struct PlayerKill {
-            Engine::PlayerHandle player;
-            std::optional<TimePoint> timestamp;
-        };
-
-        struct PlayerState {
-            std::vector<PlayerKill> killing_spree;
-            std::vector<PlayerKill> multikill_spree;
-            std::optional<PlayerKill> last_death;
-        };
-
-        MedalsStyle m_style;
-        std::vector<Medal> m_medals;
+        MedalsStyle m_style = STYLE_H4;
+        Clock m_clock;
+        MedalRegistry m_medals;
+        TextureResidency m_texture_residency = TextureResidency(m_medals);
+        MedalId m_glow_medal = MEDAL_ID_NONE;
         std::unique_ptr<RenderQueue> m_render_queue;
-        SoundPlaybackQueue m_sound_queue;
-        std::map<Engine::PlayerHandle, PlayerState> m_player_states;
-        std::string m_last_medal;
+        SoundPlaybackQueue m_sound_queue = SoundPlaybackQueue(m_clock);
+        std::vector<std::pair<SoundId, SoundScheduling>> m_medal_sounds;
+        MedalDispatcher m_dispatcher;
+        MedalHudLogWriter m_hud_log;
+        MedalEventLogWriter m_event_log;
+        std::size_t m_event_log_reported_drops = 0;
+        MedalRuleSet m_rules;
+        AtlasPacker m_atlas_packer = AtlasPacker(2048, 2048);
+        GameTick m_tick = 0;
+
+        /** Servers count medals for every player instead of showing them */
+        MedalAggregator m_aggregator;
+        bool m_aggregate = false;
 
         /** Event listeners */
         Event::MapLoadEvent::ListenerHandle m_map_load_event_listener;
+        Event::TickEvent::ListenerHandle m_tick_event_listener;
         Event::NetworkGameHudMessageEvent::ListenerHandle m_handle_multiplayer_events_listener;
         Event::NetworkGameMultiplayerSoundEvent::ListenerHandle m_multiplayer_sound_event_listener;
 
-        void dispatch_medals(Engine::NetworkGameMultiplayerHudMessage message_type, Engine::PlayerHandle causer, Engine::PlayerHandle victim, Engine::PlayerHandle local_player) noexcept;
+        void dispatch_medals(Engine::NetworkGameMultiplayerHudMessage message_type, Engine::PlayerHandle causer, Engine::PlayerHandle victim, Engine::PlayerHandle local_player, GameTick tick) noexcept;
+        void dispatch_medals(const MedalHudRecord &record) noexcept;
         bool mute_hud_message(Engine::NetworkGameMultiplayerHudMessage message_type) noexcept;
         bool mute_multiplayer_sound(Engine::NetworkGameMultiplayerSound sound) noexcept;
         void update_medals_tag_references() noexcept;
+        void pack_medals_atlas() noexcept;
+        void compile_rules(MedalRuleSet &rules, const MedalNameResolver &resolve) noexcept;
+        void compile_aggregator_rules() noexcept;
+        void update_medal_sounds_scheduling() noexcept;
+        void write_match_summary() noexcept;
         void load_style() noexcept;
         void set_up_event_listeners() noexcept;
 
     public:
-        Medal *get_medal(std::string name) noexcept;
-        void add_medal(Medal medal) noexcept;
-        void show_medal(std::string name, std::optional<Engine::PlayerHandle> player = {}) noexcept;
+        Medal *get_medal(MedalId id) noexcept;
+        Medal *get_medal(std::string_view name) noexcept;
+        MedalId add_medal(Medal medal) noexcept;
+        void show_medal(MedalId id, std::optional<Engine::PlayerHandle> player = {}) noexcept;
+        void show_medal(std::string_view name, std::optional<Engine::PlayerHandle> player = {}) noexcept;
         void show_medal(Medal *medal, std::optional<Engine::PlayerHandle> player = {});
         MedalsStyle get_style() const noexcept;
         void set_style(MedalsStyle style) noexcept;
+        void set_time_source(TimeSource source) noexcept;
+
+        /**
+         * Count medals for every player instead of showing them, as dedicated servers do
+         */
+        void aggregate_medals() noexcept;
+
+        /**
+         * Record the HUD messages handled from now on to a file; an empty path stops recording
+         */
+        bool record_hud_messages(const std::filesystem::path &path) noexcept;
+
+        /**
+         * Log the medals shown from now on to numbered files in a directory; an empty path stops logging
+         */
+        bool log_medal_events(const std::filesystem::path &directory) noexcept;
+        void print_medal_event_log_status() const noexcept;
+
+        /**
+         * Stop the event log writer thread and close the logs; call before the plugin is unloaded
+         */
+        void shut_down() noexcept;
+        const SoundQueueStats &sound_queue_stats() const noexcept;
+        const TextureResidencyStats &texture_residency_stats() const noexcept;
+        void set_texture_residency_policy(const TextureResidencyPolicy &policy) noexcept;
         MedalsHandler() noexcept;
         ~MedalsHandler() noexcept;
     };
 
     void set_up_medals();
+    void shut_down_medals() noexcept;
 }
 
 #endif
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: GPL-3.0-only
 
+#include <algorithm>
+#include <cmath>
 #include <balltze/engine/user_interface.hpp>
 #include <balltze/engine/tag.hpp>
 #include "../logger.hpp"
+#include "../profiling/counters.hpp"
+#include "../profiling/trace.hpp"
+#include "transform.hpp"
 #include "queue.hpp"
 
 using namespace Balltze;
@@ -24,9 +29,77 @@ namespace Raccoon::Medals {
         return m_max_duration_buffer.value();
     }
 
+    static Easing easing_for_curve(const Math::QuadraticBezier &curve) noexcept {
+        // Recover the control points from the curve itself; the middle one from the point at t = 0.5
+        auto start = curve.get_point(0.0f);
+        auto middle = curve.get_point(0.5f);
+        auto end = curve.get_point(1.0f);
+        auto control_x = 2 * middle.x - (start.x + end.x) / 2;
+        auto control_y = 2 * middle.y - (start.y + end.y) / 2;
+        return Easing(start.x, start.y, control_x, control_y, end.x, end.y);
+    }
+
     void MedalSequence::add_property_keyframe(MedalStateProperty property, Math::QuadraticBezier curve, Keyframe::Value value, long duration) noexcept {
-        m_properties_sequences[property].push_back({ .duration = duration, .curve = curve, .value = value });
+        m_properties_sequences[property].push_back({ .duration = duration, .curve = curve, .easing = easing_for_curve(curve), .value = value });
         m_max_duration_buffer.reset();
+        m_tracks_buffer.reset();
+        m_baked_table.reset();
+    }
+
+    MedalSequence::MedalSequence(const MedalKeyframeDefinition *keyframes, std::size_t count) noexcept {
+        for(std::size_t i = 0; i < count; i++) {
+            auto &[property, curve_type, value, duration] = keyframes[i];
+            auto curve = curve_type == MEDAL_CURVE_FLAT ? Math::QuadraticBezier::flat() : Math::QuadraticBezier::linear();
+            if(property == MEDAL_STATE_PROPERTY_POSITION_X || property == MEDAL_STATE_PROPERTY_POSITION_Y) {
+                add_property_keyframe(property, curve, { .position = value }, duration);
+            }
+            else {
+                add_property_keyframe(property, curve, { .scale = value }, duration);
+            }
+        }
+    }
+
+    const std::vector<MedalSequence::Track> &MedalSequence::tracks() noexcept {
+        if(!m_tracks_buffer.has_value()) {
+            auto &tracks = m_tracks_buffer.emplace();
+            for(const auto &[property, transitions] : m_properties_sequences) {
+                auto &track = tracks.emplace_back();
+                track.property = property;
+                track.duration = 0;
+
+                float value;
+                switch(property) {
+                    case MEDAL_STATE_PROPERTY_SCALE:
+                    case MEDAL_STATE_PROPERTY_OPACITY:
+                        value = 1.0f;
+                        break;
+                    default:
+                        value = 0.0f;
+                        break;
+                }
+
+                for(const auto &transition : transitions) {
+                    auto target = property == MEDAL_STATE_PROPERTY_POSITION_X || property == MEDAL_STATE_PROPERTY_POSITION_Y ? transition.value.position : transition.value.scale;
+                    track.starts.push_back(track.duration);
+                    track.duration += transition.duration;
+                    track.ends.push_back(track.duration);
+                    track.durations.push_back(transition.duration);
+                    track.easings.push_back(transition.easing);
+                    track.targets.push_back(target);
+                    track.values.push_back(value);
+
+                    // Position keyframes are relative to the previous ones
+                    if(property == MEDAL_STATE_PROPERTY_POSITION_X || property == MEDAL_STATE_PROPERTY_POSITION_Y) {
+                        value += target;
+                    }
+                    else {
+                        value = target;
+                    }
+                }
+                track.values.push_back(value);
+            }
+        }
+        return *m_tracks_buffer;
     }
 
     MedalState MedalSequence::get_state_at(std::chrono::milliseconds elapsed) noexcept {
@@ -38,8 +111,7 @@ namespace Raccoon::Medals {
         for (const auto &[property, transitions] : m_properties_sequences) {
             for(auto &transition : transitions) {
                 if (transition.duration > 0 && elapsed.count() < transition.duration) {
-                    auto curve_point = transition.curve.get_point(static_cast<float>(elapsed.count()) / transition.duration);
-                    auto progress = curve_point.y;
+                    auto progress = transition.easing.evaluate(static_cast<float>(elapsed.count()) / transition.duration);
                     switch (property) {
                         case MEDAL_STATE_PROPERTY_POSITION_X:
                             state.position.x += (transition.value.position - state.position.x) * progress;
@@ -84,71 +156,429 @@ namespace Raccoon::Medals {
         return state;
     }
 
-    static void rotate_rectangle(Engine::Rectangle2D &rect, Engine::Point2D center, float angle) {
-        auto rotate_point = [&center, &angle](Engine::Point2D &point) {
-            float x = point.x - center.x;
-            float y = point.y - center.y;
-            point.x = center.x + x * std::cos(angle) - y * std::sin(angle);
-            point.y = center.y + x * std::sin(angle) + y * std::cos(angle);
-        };
+    static void set_state_property(MedalState &state, MedalStateProperty property, float value) noexcept {
+        switch(property) {
+            case MEDAL_STATE_PROPERTY_POSITION_X:
+                state.position.x = value;
+                break;
+            case MEDAL_STATE_PROPERTY_POSITION_Y:
+                state.position.y = value;
+                break;
+            case MEDAL_STATE_PROPERTY_SCALE:
+                state.scale = value;
+                break;
+            case MEDAL_STATE_PROPERTY_OPACITY:
+                state.color_mask.alpha = static_cast<std::uint8_t>(value * 255);
+                break;
+            case MEDAL_STATE_PROPERTY_ROTATION:
+                state.rotation = value;
+                break;
+        }
+    }
 
-        Engine::Point2D points[4] = {
-            {static_cast<float>(rect.left), static_cast<float>(rect.top)},
-            {static_cast<float>(rect.right), static_cast<float>(rect.top)},
-            {static_cast<float>(rect.right), static_cast<float>(rect.bottom)},
-            {static_cast<float>(rect.left), static_cast<float>(rect.bottom)}
-        };
+    static void interpolate_state_property(MedalState &state, MedalStateProperty property, float target, float progress) noexcept {
+        switch(property) {
+            case MEDAL_STATE_PROPERTY_POSITION_X:
+                state.position.x += (target - state.position.x) * progress;
+                break;
+            case MEDAL_STATE_PROPERTY_POSITION_Y:
+                state.position.y += (target - state.position.y) * progress;
+                break;
+            case MEDAL_STATE_PROPERTY_SCALE:
+                state.scale += (target - state.scale) * progress;
+                break;
+            case MEDAL_STATE_PROPERTY_OPACITY:
+                state.color_mask.alpha += (target * 255 - state.color_mask.alpha) * progress;
+                break;
+            case MEDAL_STATE_PROPERTY_ROTATION:
+                state.rotation += (target - state.rotation) * progress;
+                break;
+        }
+    }
 
-        for(auto &point : points) {
-            rotate_point(point);
+    MedalState MedalSequence::get_state_at(std::chrono::milliseconds elapsed, Cursor &cursor) noexcept {
+        if(m_baked_table) {
+            return get_baked_state_at(elapsed);
         }
 
-        rect.left = points[0].x;
-        rect.top = points[0].y;
-        rect.right = points[0].x;
-        rect.bottom = points[0].y;
+        MedalState state;
+        if(elapsed.count() > duration()) {
+            state.sequence_finished = true;
+        }
+
+        auto &sequence_tracks = tracks();
+        auto time = elapsed.count();
+        for(std::size_t i = 0; i < sequence_tracks.size(); i++) {
+            auto &track = sequence_tracks[i];
+            auto &keyframe = cursor.keyframes[i];
+            auto keyframes_count = track.durations.size();
+
+            // Rewind if time went backwards (or the cursor belongs to an older build of the tracks)
+            if(keyframe > keyframes_count || (keyframe > 0 && time < track.ends[keyframe - 1])) {
+                keyframe = 0;
+            }
+            while(keyframe < keyframes_count && (track.durations[keyframe] <= 0 || time >= track.ends[keyframe])) {
+                keyframe++;
+            }
 
-        for(auto &point : points) {
-            rect.left = std::min(rect.left, static_cast<std::int16_t>(point.x));
-            rect.top = std::min(rect.top, static_cast<std::int16_t>(point.y));
-            rect.right = std::max(rect.right, static_cast<std::int16_t>(point.x));
-            rect.bottom = std::max(rect.bottom, static_cast<std::int16_t>(point.y));
+            set_state_property(state, track.property, track.values[keyframe]);
+            if(keyframe < keyframes_count) {
+                auto progress = track.easings[keyframe].evaluate(static_cast<float>(time - track.starts[keyframe]) / track.durations[keyframe]);
+                interpolate_state_property(state, track.property, track.targets[keyframe], progress);
+                
+                // Same as get_state_at, time taken by finished keyframes is carried to the next track
+                time -= track.starts[keyframe];
+            }
+            else {
+                time -= track.duration;
+            }
         }
+        return state;
     }
 
-    MedalState Medal::draw(Engine::Point2D offset, std::optional<TimePoint> creation_time) const noexcept {
-        if(m_bitmaps.empty()) {
-            logger.debug("No bitmaps loaded for medal {}", m_name);
-            return { .sequence_finished = true };
+    void MedalSequence::bake(std::chrono::milliseconds step) noexcept {
+        auto step_ms = std::max<long>(step.count(), 1);
+        m_baked_table.reset();
+
+        // Sample one step past the end so the last interval always has both ends
+        BakedTable table = { .step = step_ms, .duration = duration(), .samples = {} };
+        auto samples_count = table.duration / step_ms + 2;
+        table.samples.reserve(samples_count);
+        Cursor cursor;
+        for(long i = 0; i < samples_count; i++) {
+            auto state = get_state_at(std::chrono::milliseconds(i * step_ms), cursor);
+            table.samples.push_back({ 
+                .position_x = state.position.x, 
+                .position_y = state.position.y, 
+                .scale = state.scale, 
+                .opacity = static_cast<float>(state.color_mask.alpha), 
+                .rotation = state.rotation 
+            });
         }
+        m_baked_table = std::move(table);
+    }
 
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - *creation_time);
-        auto state = m_sequence->get_state_at(elapsed);
-        Engine::Rectangle2D draw_rect;
-        draw_rect.left = state.position.x + offset.x - (m_width * (state.scale - 1.0)) / 2;
-        draw_rect.top = state.position.y + offset.y - (m_height * (state.scale - 1.0)) / 2;
-        draw_rect.right = draw_rect.left + m_width * state.scale;
-        draw_rect.bottom = draw_rect.top + m_height * state.scale;
-
-        Engine::Point2D center = {
-            draw_rect.left + static_cast<float>(m_width * state.scale) / 2,
-            draw_rect.top + static_cast<float>(m_height * state.scale) / 2
+    bool MedalSequence::baked() const noexcept {
+        return m_baked_table.has_value();
+    }
+
+    MedalState MedalSequence::get_baked_state_at(std::chrono::milliseconds elapsed) const noexcept {
+        auto &[step, duration, samples] = *m_baked_table;
+        auto time = std::max<std::chrono::milliseconds::rep>(elapsed.count(), 0);
+        auto index = static_cast<std::size_t>(time / step);
+
+        MedalState state;
+        if(index + 1 >= samples.size()) {
+            auto &last = samples.back();
+            state.position = { last.position_x, last.position_y };
+            state.scale = last.scale;
+            state.color_mask.alpha = static_cast<std::uint8_t>(last.opacity);
+            state.rotation = last.rotation;
+        }
+        else {
+            auto &from = samples[index];
+            auto &to = samples[index + 1];
+            float progress = static_cast<float>(time % step) / step;
+            state.position.x = from.position_x + (to.position_x - from.position_x) * progress;
+            state.position.y = from.position_y + (to.position_y - from.position_y) * progress;
+            state.scale = from.scale + (to.scale - from.scale) * progress;
+            state.color_mask.alpha = static_cast<std::uint8_t>(from.opacity + (to.opacity - from.opacity) * progress);
+            state.rotation = from.rotation + (to.rotation - from.rotation) * progress;
+        }
+
+        state.sequence_finished = elapsed.count() > duration;
+        return state;
+    }
+
+    MedalSequence::BakeError MedalSequence::measure_bake_error() noexcept {
+        BakeError error;
+        if(!m_baked_table) {
+            return error;
+        }
+
+        auto sequence_duration = duration();
+        for(long i = 0; i <= sequence_duration + m_baked_table->step; i++) {
+            auto elapsed = std::chrono::milliseconds(i);
+            auto exact = get_state_at(elapsed);
+            auto baked = get_baked_state_at(elapsed);
+            error.position = std::max({ error.position, std::abs(exact.position.x - baked.position.x), std::abs(exact.position.y - baked.position.y) });
+            error.scale = std::max(error.scale, std::abs(exact.scale - baked.scale));
+            error.opacity = std::max(error.opacity, std::abs(static_cast<float>(exact.color_mask.alpha) - baked.color_mask.alpha));
+            error.rotation = std::max(error.rotation, std::abs(exact.rotation - baked.rotation));
+        }
+        return error;
+    }
+
+    void MedalSequence::get_exact_states_at(MedalStateBatch &batch) noexcept {
+        auto count = batch.size();
+        auto sequence_duration = duration();
+        for(std::size_t i = 0; i < count; i++) {
+            MedalState state;
+            batch.times[i] = batch.elapsed[i];
+            batch.position_x[i] = state.position.x;
+            batch.position_y[i] = state.position.y;
+            batch.scale[i] = state.scale;
+            batch.opacity[i] = state.color_mask.alpha;
+            batch.rotation[i] = state.rotation;
+            batch.sequence_finished[i] = batch.elapsed[i] > sequence_duration;
+            if(!batch.cursors[i]) {
+                batch.scratch_cursors[i] = {};
+            }
+        }
+
+        // Opacity goes through the same 0-255 truncation as MedalState::color_mask so both paths agree
+        auto output_for = [&](MedalStateProperty property) -> std::vector<float> & {
+            switch(property) {
+                case MEDAL_STATE_PROPERTY_POSITION_X:
+                    return batch.position_x;
+                case MEDAL_STATE_PROPERTY_POSITION_Y:
+                    return batch.position_y;
+                case MEDAL_STATE_PROPERTY_SCALE:
+                    return batch.scale;
+                case MEDAL_STATE_PROPERTY_OPACITY:
+                    return batch.opacity;
+                default:
+                    return batch.rotation;
+            }
         };
 
-        if(state.rotation != 0) {
-            rotate_rectangle(draw_rect, center, state.rotation);
+        auto &sequence_tracks = tracks();
+        for(std::size_t t = 0; t < sequence_tracks.size(); t++) {
+            auto &track = sequence_tracks[t];
+            auto keyframes_count = track.durations.size();
+            auto opacity = track.property == MEDAL_STATE_PROPERTY_OPACITY;
+            auto units = opacity ? 255.0f : 1.0f;
+            auto &output = output_for(track.property);
+
+            // Same cursor walk as get_state_at, then every entry gets the value before its keyframe
+            for(std::size_t i = 0; i < count; i++) {
+                auto &cursor = batch.cursors[i] ? *batch.cursors[i] : batch.scratch_cursors[i];
+                auto &keyframe = cursor.keyframes[t];
+                auto time = batch.times[i];
+                if(keyframe > keyframes_count || (keyframe > 0 && time < track.ends[keyframe - 1])) {
+                    keyframe = 0;
+                }
+                while(keyframe < keyframes_count && (track.durations[keyframe] <= 0 || time >= track.ends[keyframe])) {
+                    keyframe++;
+                }
+                batch.track_keyframes[i] = keyframe;
+                auto value = track.values[keyframe] * units;
+                output[i] = opacity ? static_cast<std::uint8_t>(value) : value;
+            }
+
+            // Entries in the same keyframe share its easing, so they go through the batched easing together
+            for(std::size_t keyframe = 0; keyframe < keyframes_count; keyframe++) {
+                std::size_t easing_count = 0;
+                for(std::size_t i = 0; i < count; i++) {
+                    if(batch.track_keyframes[i] == keyframe) {
+                        batch.easing_entries[easing_count] = i;
+                        batch.easing_times[easing_count] = static_cast<float>(batch.times[i] - track.starts[keyframe]) / track.durations[keyframe];
+                        easing_count++;
+                    }
+                }
+                if(easing_count == 0) {
+                    continue;
+                }
+
+                track.easings[keyframe].evaluate(batch.easing_times.data(), batch.easing_values.data(), easing_count);
+                auto target = track.targets[keyframe] * units;
+                for(std::size_t e = 0; e < easing_count; e++) {
+                    auto &value = output[batch.easing_entries[e]];
+                    auto interpolated = value + (target - value) * batch.easing_values[e];
+                    value = opacity ? static_cast<std::uint8_t>(interpolated) : interpolated;
+                }
+            }
+
+            for(std::size_t i = 0; i < count; i++) {
+                auto keyframe = batch.track_keyframes[i];
+                batch.times[i] -= keyframe < keyframes_count ? track.starts[keyframe] : track.duration;
+            }
+        }
+    }
+
+    void MedalSequence::get_states_at(MedalStateBatch &batch) noexcept {
+        auto count = batch.size();
+        batch.resize_outputs();
+
+        if(!m_baked_table) {
+            get_exact_states_at(batch);
+            return;
+        }
+
+        auto &[step, duration, samples] = *m_baked_table;
+        auto last_sample = samples.size() - 1;
+        for(std::size_t i = 0; i < count; i++) {
+            auto time = std::max<std::chrono::milliseconds::rep>(batch.elapsed[i], 0);
+            auto index = static_cast<std::size_t>(time / step);
+            if(index >= last_sample) {
+                batch.samples_from[i] = last_sample;
+                batch.samples_to[i] = last_sample;
+                batch.samples_progress[i] = 0.0f;
+            }
+            else {
+                batch.samples_from[i] = index;
+                batch.samples_to[i] = index + 1;
+                batch.samples_progress[i] = static_cast<float>(time % step) / step;
+            }
+            batch.sequence_finished[i] = batch.elapsed[i] > duration;
+        }
+
+        static constexpr float BakedSample::*components[] = {
+            &BakedSample::position_x,
+            &BakedSample::position_y,
+            &BakedSample::scale,
+            &BakedSample::opacity,
+            &BakedSample::rotation
+        };
+        std::vector<float> *outputs[] = { &batch.position_x, &batch.position_y, &batch.scale, &batch.opacity, &batch.rotation };
+
+        for(std::size_t c = 0; c < std::size(components); c++) {
+            auto component = components[c];
+            for(std::size_t i = 0; i < count; i++) {
+                batch.values_from[i] = samples[batch.samples_from[i]].*component;
+                batch.values_to[i] = samples[batch.samples_to[i]].*component;
+            }
+
+            // Plain arrays without aliasing so the compiler can vectorize the lerp
+            const float *__restrict from = batch.values_from.data();
+            const float *__restrict to = batch.values_to.data();
+            const float *__restrict progress = batch.samples_progress.data();
+            float *__restrict output = outputs[c]->data();
+            for(std::size_t i = 0; i < count; i++) {
+                output[i] = from[i] + (to[i] - from[i]) * progress[i];
+            }
+        }
+    }
+
+    std::size_t MedalStateBatch::size() const noexcept {
+        return elapsed.size();
+    }
+
+    void MedalStateBatch::clear() noexcept {
+        elapsed.clear();
+        cursors.clear();
+    }
+
+    void MedalStateBatch::push(std::chrono::milliseconds elapsed_time, MedalSequence::Cursor *cursor) noexcept {
+        elapsed.push_back(elapsed_time.count());
+        cursors.push_back(cursor);
+    }
+
+    void MedalStateBatch::resize_outputs() noexcept {
+        auto count = size();
+        for(auto *buffer : { &position_x, &position_y, &scale, &opacity, &rotation, &samples_progress, &values_from, &values_to }) {
+            buffer->resize(count);
         }
+        samples_from.resize(count);
+        samples_to.resize(count);
+        sequence_finished.resize(count);
+        times.resize(count);
+        scratch_cursors.resize(count);
+        track_keyframes.resize(count);
+        easing_entries.resize(count);
+        easing_times.resize(count);
+        easing_values.resize(count);
+    }
 
-        auto color_mask = state.color_mask;
+    MedalState MedalStateBatch::state(std::size_t index) const noexcept {
+        MedalState state;
+        state.position = { position_x[index], position_y[index] };
+        state.scale = scale[index];
+        state.color_mask.alpha = static_cast<std::uint8_t>(opacity[index]);
+        state.rotation = rotation[index];
+        state.sequence_finished = sequence_finished[index];
+        return state;
+    }
 
+    /**
+     * Round sprite bounds to the pixel rectangle the engine draws
+     */
+    static Engine::Rectangle2D engine_draw_rect(const SpriteRect &bounds) noexcept {
+        Engine::Rectangle2D draw_rect;
+        draw_rect.left = static_cast<std::int16_t>(std::lround(bounds.left));
+        draw_rect.top = static_cast<std::int16_t>(std::lround(bounds.top));
+        draw_rect.right = static_cast<std::int16_t>(std::lround(bounds.right));
+        draw_rect.bottom = static_cast<std::int16_t>(std::lround(bounds.bottom));
+        return draw_rect;
+    }
+
+    MedalState Medal::draw(Engine::Point2D offset, std::optional<TimePoint> creation_time) const noexcept {
+        MedalSequence::Cursor cursor;
+        return draw(offset, creation_time, cursor);
+    }
+
+    MedalState Medal::draw(Engine::Point2D offset, std::optional<TimePoint> creation_time, MedalSequence::Cursor &cursor) const noexcept {
+        return draw(offset, creation_time, std::chrono::steady_clock::now(), cursor);
+    }
+
+    MedalState Medal::draw(Engine::Point2D offset, std::optional<TimePoint> creation_time, TimePoint now, MedalSequence::Cursor &cursor) const noexcept {
+        auto elapsed = creation_time ? milliseconds_between(*creation_time, now) : std::chrono::milliseconds(0);
+        return draw(offset, elapsed, get_state_at(elapsed, cursor));
+    }
+
+    MedalState Medal::draw(Engine::Point2D offset, std::chrono::milliseconds elapsed, MedalState state) const noexcept {
+        auto *bitmap = get_bitmap_at(elapsed);
+        if(!bitmap) {
+            logger.debug("No bitmaps loaded for medal {}", m_name);
+            return { .sequence_finished = true };
+        }
+        Engine::draw_bitmap_in_rect(bitmap, get_draw_rect(offset, state), state.color_mask);
+        return state;
+    }
+
+    std::size_t Medal::get_frame_index_at(std::chrono::milliseconds elapsed) const noexcept {
         std::uint8_t frame = 0;
         if(m_fps > 0) {
             frame = round(elapsed.count() / (1000 / m_fps) % m_bitmaps.size());
         }
+        return frame;
+    }
 
-        Engine::draw_bitmap_in_rect(m_bitmaps[frame], draw_rect, color_mask);
+    Engine::TagDefinitions::BitmapData *Medal::get_bitmap_at(std::chrono::milliseconds elapsed) const noexcept {
+        if(m_bitmaps.empty()) {
+            return nullptr;
+        }
+        return m_bitmaps[get_frame_index_at(elapsed)];
+    }
 
-        return state;
+    const MedalAtlasFrame *Medal::get_atlas_frame_at(std::chrono::milliseconds elapsed) const noexcept {
+        if(m_bitmaps.empty() || m_atlas_frames.size() != m_bitmaps.size()) {
+            return nullptr;
+        }
+        return &m_atlas_frames[get_frame_index_at(elapsed)];
+    }
+
+    const std::vector<Engine::TagDefinitions::BitmapData *> &Medal::bitmaps() const noexcept {
+        return m_bitmaps;
+    }
+
+    void Medal::set_atlas_frames(std::vector<MedalAtlasFrame> frames) noexcept {
+        m_atlas_frames = std::move(frames);
+    }
+
+    Engine::Rectangle2D Medal::get_draw_rect(Engine::Point2D offset, const MedalState &state) const noexcept {
+        float center_x = state.position.x + offset.x + m_width / 2.0f;
+        float center_y = state.position.y + offset.y + m_height / 2.0f;
+        auto transform = SpriteTransform::make(center_x, center_y, state.scale, state.rotation);
+        auto bounds = sprite_corners_bounds(transform_sprite_corners(transform, m_width, m_height));
+
+        return engine_draw_rect(bounds);
+    }
+
+    MedalState Medal::get_state_at(std::chrono::milliseconds elapsed, MedalSequence::Cursor &cursor) const noexcept {
+        return m_sequence->get_state_at(elapsed, cursor);
+    }
+
+    void Medal::get_states_at(MedalStateBatch &batch) const noexcept {
+        m_sequence->get_states_at(batch);
+    }
+
+    MedalId Medal::id() const noexcept {
+        return m_id;
+    }
+
+    void Medal::set_id(MedalId id) noexcept {
+        m_id = id;
     }
 
     const std::string &Medal::name() const noexcept {
@@ -163,6 +593,14 @@ namespace Raccoon::Medals {
         return m_height;
     }
 
+    std::uint8_t Medal::tier() const noexcept {
+        return m_tier;
+    }
+
+    void Medal::set_tier(std::uint8_t tier) noexcept {
+        m_tier = tier;
+    }
+
     std::optional<std::string> Medal::sound_tag_path() const noexcept {
         return m_sound_tag_path;
     }
@@ -175,55 +613,234 @@ namespace Raccoon::Medals {
         return m_sequence;
     }
 
-    void Medal::reload_bitmap_tag() noexcept {
+    void Medal::reload_bitmap_tag(bool load_textures) noexcept {
         auto *bitmap_tag = Engine::get_tag(m_bitmap_tag_path, Engine::TAG_CLASS_BITMAP);
         if(!bitmap_tag) {
             return;
         }
         auto *bitmap = reinterpret_cast<Engine::TagDefinitions::Bitmap *>(bitmap_tag->data);
         m_bitmaps.clear();
+        m_atlas_frames.clear();
         for(std::size_t i = 0; i < bitmap->bitmap_data.count; i++) {
-            Engine::load_bitmap_data_texture(bitmap->bitmap_data.elements + i, true, true);
             m_bitmaps.push_back(bitmap->bitmap_data.elements + i);
         }
+        if(load_textures) {
+            load_bitmap_textures();
+        }
+    }
+
+    void Medal::load_bitmap_textures() noexcept {
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_TEXTURE_RELOAD, m_id);
+        for(auto *bitmap : m_bitmaps) {
+            Engine::load_bitmap_data_texture(bitmap, true, true);
+        }
+    }
+
+    void Medal::free_bitmap_textures() noexcept {
+        for(auto *bitmap : m_bitmaps) {
+            Engine::free_bitmap_data_texture(bitmap);
+        }
+    }
+
+    std::size_t Medal::bitmap_bytes() const noexcept {
+        std::size_t bytes = 0;
+        for(auto *bitmap : m_bitmaps) {
+            bytes += bitmap->pixel_data_size;
+        }
+        return bytes;
+    }
+
+    void EngineSpriteBackend::submit(const SpriteQuad *quads, std::size_t count) noexcept {
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_MEDAL_DRAW);
+        // The engine draws one bitmap per call, so a batch is just its quads back to back
+        for(std::size_t i = 0; i < count; i++) {
+            auto &[texture, blend_mode, layer, atlas_page, uv, corners, rect, color] = quads[i];
+            auto draw_rect = engine_draw_rect(rect);
+            Engine::ColorARGBInt color_mask;
+            color_mask.alpha = color.alpha;
+            color_mask.red = color.red;
+            color_mask.green = color.green;
+            color_mask.blue = color.blue;
+            Engine::draw_bitmap_in_rect(texture, draw_rect, color_mask);
+        }
+    }
+
+    void SoundPlaybackQueue::resolve_sound(CachedSound &cached_sound) noexcept {
+        cached_sound.sound = nullptr;
+        cached_sound.permutations_count = 0;
+        cached_sound.longest_duration = {};
+
+        auto *sound_tag = Engine::get_tag(cached_sound.tag_path, Engine::TAG_CLASS_SOUND);
+        if(!sound_tag) {
+            return;
+        }
+        cached_sound.handle = sound_tag->handle;
+        cached_sound.sound = reinterpret_cast<Engine::TagDefinitions::Sound *>(sound_tag->data);
+        cached_sound.first_permutation = m_permutation_durations.size();
+        auto &pitch_ranges = cached_sound.sound->pitch_ranges;
+        for(std::size_t i = 0; i < pitch_ranges.count; i++) {
+            auto &permutations = pitch_ranges.elements[i].permutations;
+            for(std::size_t j = 0; j < permutations.count; j++) {
+                auto *permutation = permutations.elements + j;
+                auto duration = Engine::get_sound_permutation_samples_duration(permutation);
+                m_permutation_durations.push_back({ permutation, duration });
+                cached_sound.longest_duration = std::max(cached_sound.longest_duration, duration);
+            }
+        }
+        cached_sound.permutations_count = m_permutation_durations.size() - cached_sound.first_permutation;
+    }
+
+    void SoundPlaybackQueue::play_next_sound(TimePoint now) noexcept {
+        while(!m_queue.empty()) {
+            auto [sound, scheduling, queued_time] = m_queue.front();
+            Profiling::trace_instant(Profiling::TRACE_EVENT_SOUND_QUEUE_POP, m_queue.size() - 1);
+            m_queue.pop_front();
+
+            auto &cached_sound = m_sounds[sound];
+            if(!cached_sound.sound) {
+                continue;
+            }
+            auto delay = milliseconds_between(queued_time, now);
+            if(m_policy.max_latency.count() > 0 && delay > m_policy.max_latency) {
+                m_stats.expired++;
+                continue;
+            }
+
+            m_stats.played++;
+            m_stats.last_delay = delay;
+            m_stats.max_delay = std::max(m_stats.max_delay, delay);
+            m_stats.total_delay += delay;
+            Profiling::trace_instant(Profiling::TRACE_EVENT_SOUND_START, delay.count());
+            m_current_sound = sound;
+            m_current_sound_start = now;
+            m_current_sound_duration = cached_sound.longest_duration;
+            Engine::play_sound(cached_sound.handle);
+            return;
+        }
+    }
+
+    SoundId SoundPlaybackQueue::add_sound(std::string tag_path) noexcept {
+        for(std::size_t i = 0; i < m_sounds.size(); i++) {
+            if(m_sounds[i].tag_path == tag_path) {
+                return static_cast<SoundId>(i);
+            }
+        }
+        if(m_sounds.size() >= SOUND_ID_NONE) {
+            return SOUND_ID_NONE;
+        }
+        m_sounds.push_back({ .tag_path = std::move(tag_path) });
+        return static_cast<SoundId>(m_sounds.size() - 1);
+    }
+
+    void SoundPlaybackQueue::resolve_sounds() noexcept {
+        // The current sound's tag data goes away with the map
+        m_current_sound = SOUND_ID_NONE;
+        m_queue.clear();
+        m_permutation_durations.clear();
+        for(auto &cached_sound : m_sounds) {
+            resolve_sound(cached_sound);
+        }
+    }
+
+    void SoundPlaybackQueue::clear_sounds() noexcept {
+        m_current_sound = SOUND_ID_NONE;
+        m_queue.clear();
+        m_sounds.clear();
+        m_permutation_durations.clear();
     }
 
-    SoundPlaybackQueue::SoundPlaybackQueue() noexcept {
+    void SoundPlaybackQueue::enqueue_sound(SoundId sound, const SoundScheduling &scheduling) noexcept {
+        if(sound >= m_sounds.size()) {
+            return;
+        }
+
+        auto &[priority, supersede_group, supersede_rank] = scheduling;
+        if(supersede_group != 0) {
+            for(std::size_t i = 0; i < m_queue.size(); i++) {
+                auto &queued = m_queue[i].scheduling;
+                if(queued.supersede_group != supersede_group) {
+                    continue;
+                }
+                if(queued.supersede_rank > supersede_rank) {
+                    m_stats.rejected++;
+                    return;
+                }
+                m_queue.erase(i);
+                m_stats.superseded++;
+                break;
+            }
+        }
+
+        if(m_queue.full()) {
+            // Make room by dropping the newest sound of the lowest priority, as long as it is below the new one
+            std::size_t lowest = 0;
+            for(std::size_t i = 1; i < m_queue.size(); i++) {
+                if(m_queue[i].scheduling.priority <= m_queue[lowest].scheduling.priority) {
+                    lowest = i;
+                }
+            }
+            if(m_queue[lowest].scheduling.priority >= priority) {
+                m_stats.rejected++;
+                return;
+            }
+            m_queue.erase(lowest);
+            m_stats.overflowed++;
+        }
+
+        auto position = m_queue.size();
+        for(std::size_t i = 0; i < m_queue.size(); i++) {
+            if(m_queue[i].scheduling.priority < priority) {
+                position = i;
+                break;
+            }
+        }
+        m_queue.insert(position, { sound, scheduling, m_clock.now() });
+        Profiling::trace_instant(Profiling::TRACE_EVENT_SOUND_QUEUE_PUSH, m_queue.size());
+    }
+
+    void SoundPlaybackQueue::enqueue_sound(const std::string &sound_tag_path, const SoundScheduling &scheduling) noexcept {
+        auto sound = add_sound(sound_tag_path);
+        if(sound != SOUND_ID_NONE && !m_sounds[sound].sound) {
+            resolve_sound(m_sounds[sound]);
+        }
+        enqueue_sound(sound, scheduling);
+    }
+
+    void SoundPlaybackQueue::set_policy(const SoundQueuePolicy &policy) noexcept {
+        m_policy = policy;
+    }
+
+    const SoundQueueStats &SoundPlaybackQueue::stats() const noexcept {
+        return m_stats;
+    }
+
+    SoundPlaybackQueue::SoundPlaybackQueue(const Clock &clock) noexcept : m_clock(clock) {
         m_tick_event_listener = Event::TickEvent::subscribe_const([this](const auto &event) {
             if(event.time == Event::EVENT_TIME_AFTER) {
-                if(m_current_playing_sound_start) {
-                    if(m_current_playing_sound_duration) {
-                        auto now = std::chrono::steady_clock::now();
-                        auto current_playing_sound_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - *m_current_playing_sound_start).count();
-                        if(current_playing_sound_elapsed >= *m_current_playing_sound_duration && !m_queue.empty()) {
-                            m_queue.pop();
-                            m_current_playing_sound_start = std::nullopt;
-                            m_current_playing_sound = nullptr;
-                        }
-                    }
+                RACCOON_PROFILE_SCOPE(PROFILE_SECTION_SOUND_QUEUE_TICK);
+                auto now = m_clock.now();
+                if(m_current_sound != SOUND_ID_NONE && milliseconds_between(m_current_sound_start, now) >= m_current_sound_duration) {
+                    m_current_sound = SOUND_ID_NONE;
                 }
-                else {
-                    if(!m_queue.empty()) {
-                        auto *sound_tag = Engine::get_tag(m_queue.front(), Engine::TAG_CLASS_SOUND);
-                        if(sound_tag) {
-                            m_current_playing_sound_start = std::chrono::steady_clock::now();
-                            Engine::play_sound(sound_tag->handle);
-                            m_current_playing_sound = reinterpret_cast<Engine::TagDefinitions::Sound *>(sound_tag->data);
-                        }
-                        else {
-                            m_queue.pop();
-                        }
-                    }
+                if(m_current_sound == SOUND_ID_NONE) {
+                    play_next_sound(now);
                 }
             }
         });
 
         m_sound_playback_event_listener = Event::SoundPlaybackEvent::subscribe_const([this](const auto &event) {
-            if(event.time == Event::EVENT_TIME_AFTER && !event.cancelled()) {
+            if(event.time == Event::EVENT_TIME_AFTER && !event.cancelled() && m_current_sound != SOUND_ID_NONE) {
                 auto &[sound, permutation] = event.context;
-                if(!m_current_playing_sound_duration && m_current_playing_sound && m_current_playing_sound == sound) {
-                    auto duration = Engine::get_sound_permutation_samples_duration(permutation);
-                    m_current_playing_sound_duration = duration.count();
+                auto &cached_sound = m_sounds[m_current_sound];
+                if(cached_sound.sound != sound) {
+                    return;
+                }
+                for(std::size_t i = 0; i < cached_sound.permutations_count; i++) {
+                    auto &permutation_duration = m_permutation_durations[cached_sound.first_permutation + i];
+                    if(permutation_duration.permutation == permutation) {
+                        m_current_sound_duration = permutation_duration.duration;
+                        break;
+                    }
                 }
             }
         }, Event::EVENT_PRIORITY_HIGHEST);
@@ -234,22 +851,18 @@ namespace Raccoon::Medals {
         m_sound_playback_event_listener.remove();
     }
 
-    void SoundPlaybackQueue::enqueue_sound(std::string sound_tag_path) noexcept {
-        m_queue.push(sound_tag_path);
-    }
-
-    RenderQueue::RenderQueue(std::size_t max_renders) noexcept
-        : m_max_renders(max_renders) {
+    RenderQueue::RenderQueue(std::size_t max_renders, const Clock &clock) noexcept
+        : m_clock(clock), m_max_renders(std::min(max_renders, max_renders_capacity)) {
         m_render_event_listener = Event::UIRenderEvent::subscribe_const([this](const auto &event) {
             if(event.time == Event::EVENT_TIME_BEFORE) {
-                render();
+                render(m_clock.now());
             }
         });
 
         m_map_load_event_listener = Event::MapLoadEvent::subscribe([this](const auto &event) {
             if(event.time == Event::EVENT_TIME_AFTER) {
-                m_queue = {};
-                m_renders = {};
+                m_queue.clear();
+                m_renders.clear();
             }
         });
     }
@@ -260,6 +873,65 @@ namespace Raccoon::Medals {
     }
 
     void RenderQueue::show_medal(const Medal *medal) noexcept {
-        m_queue.push(medal);
+        Profiling::trace_instant(Profiling::TRACE_EVENT_RENDER_QUEUE_PUSH, medal->id());
+        auto tier = medal->tier();
+        if(tier <= m_policy.coalesce_max_tier) {
+            for(std::size_t i = 0; i < m_queue.size(); i++) {
+                if(m_queue[i].medal == medal) {
+                    m_stats.coalesced++;
+                    return;
+                }
+            }
+        }
+
+        if(m_queue.full()) {
+            // Make room by dropping the oldest medal of the lowest tier, as long as it is below the new one
+            std::size_t lowest = 0;
+            for(std::size_t i = 1; i < m_queue.size(); i++) {
+                if(m_queue[i].medal->tier() < m_queue[lowest].medal->tier()) {
+                    lowest = i;
+                }
+            }
+            m_stats.overflowed++;
+            if(m_queue[lowest].medal->tier() >= tier) {
+                return;
+            }
+            m_queue.erase(lowest);
+        }
+
+        PendingMedal pending = { medal, m_clock.now() };
+        auto position = m_queue.size();
+        if(tier >= m_policy.priority_min_tier) {
+            for(std::size_t i = 0; i < m_queue.size(); i++) {
+                if(m_queue[i].medal->tier() < tier) {
+                    position = i;
+                    break;
+                }
+            }
+        }
+        m_queue.insert(position, pending);
+    }
+
+    void RenderQueue::drop_stale_medals(TimePoint now) noexcept {
+        if(m_policy.max_pending_age.count() <= 0) {
+            return;
+        }
+        for(std::size_t i = 0; i < m_queue.size();) {
+            if(milliseconds_between(m_queue[i].queued_time, now) > m_policy.max_pending_age) {
+                m_queue.erase(i);
+                m_stats.expired++;
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    void RenderQueue::set_policy(const RenderQueuePolicy &policy) noexcept {
+        m_policy = policy;
+    }
+
+    const RenderQueueStats &RenderQueue::stats() const noexcept {
+        return m_stats;
     }
 }
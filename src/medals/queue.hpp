@@ -4,37 +4,176 @@
 #define RACCOON__MEDALS__BASE_HPP
 
 #include <raccoon/medals.hpp>
+#include "clock.hpp"
+#include "ring_buffer.hpp"
+#include "sprite_batch.hpp"
 
 namespace Raccoon::Medals {
+    class EngineSpriteBackend : public SpriteBatchBackend {
+    public:
+        void submit(const SpriteQuad *quads, std::size_t count) noexcept override;
+    };
+
+    using SoundId = std::uint16_t;
+    constexpr SoundId SOUND_ID_NONE = 0xFFFF;
+
+    /**
+     * Where a sound goes in the queue. Higher priorities play first. A sound replaces a 
+     * waiting one of the same supersede group (zero is none) unless that one has a higher 
+     * rank, so a triple kill call takes the place of a double kill that hasn't played yet.
+     */
+    struct SoundScheduling {
+        std::uint8_t priority = 0;
+        std::uint8_t supersede_group = 0;
+        std::uint32_t supersede_rank = 0;
+    };
+
+    /**
+     * Sounds waiting longer than max_latency are skipped so the announcer doesn't fall 
+     * behind what is on screen; zero disables it.
+     */
+    struct SoundQueuePolicy {
+        std::chrono::milliseconds max_latency = std::chrono::milliseconds(3000);
+    };
+
+    struct SoundQueueStats {
+        std::size_t played = 0;
+        std::size_t superseded = 0;
+        std::size_t expired = 0;
+        std::size_t overflowed = 0;
+        /** Sounds turned away on arrival by a higher ranked or higher priority queued sound */
+        std::size_t rejected = 0;
+        /** Time between queueing and playing */
+        std::chrono::milliseconds last_delay = {};
+        std::chrono::milliseconds max_delay = {};
+        std::chrono::milliseconds total_delay = {};
+    };
+
+    /**
+     * Plays queued sounds one after another. Sound tags are registered by path once and 
+     * resolved to handles and permutation durations on every map load, so queueing and 
+     * the tick only move small IDs around. The next sound starts on the tick the current 
+     * one ends.
+     */
     class SoundPlaybackQueue {
+    public:
+        static constexpr std::size_t queue_capacity = 32;
+
     private:
-        std::optional<std::chrono::steady_clock::time_point> m_current_playing_sound_start;
-        std::optional<std::int64_t> m_current_playing_sound_duration;
-        Engine::TagDefinitions::Sound *m_current_playing_sound = nullptr;
-        std::queue<std::string> m_queue;
+        struct CachedSound {
+            std::string tag_path;
+            Engine::TagHandle handle = Engine::TagHandle::null();
+            Engine::TagDefinitions::Sound *sound = nullptr;
+            std::size_t first_permutation = 0;
+            std::size_t permutations_count = 0;
+            /** Used until the engine reports which permutation it picked */
+            std::chrono::milliseconds longest_duration = {};
+        };
+
+        struct PermutationDuration {
+            const Engine::TagDefinitions::SoundPermutation *permutation;
+            std::chrono::milliseconds duration;
+        };
+
+        struct QueuedSound {
+            SoundId sound;
+            SoundScheduling scheduling;
+            TimePoint queued_time;
+        };
+
+        const Clock &m_clock;
+        std::vector<CachedSound> m_sounds;
+        std::vector<PermutationDuration> m_permutation_durations;
+        RingBuffer<QueuedSound, queue_capacity> m_queue;
+        SoundId m_current_sound = SOUND_ID_NONE;
+        TimePoint m_current_sound_start;
+        std::chrono::milliseconds m_current_sound_duration = {};
+        SoundQueuePolicy m_policy;
+        SoundQueueStats m_stats;
         Event::TickEvent::ListenerHandle m_tick_event_listener;
         Event::SoundPlaybackEvent::ListenerHandle m_sound_playback_event_listener;
 
+        void resolve_sound(CachedSound &sound) noexcept;
+        void play_next_sound(TimePoint now) noexcept;
+
     public:
-        SoundPlaybackQueue() noexcept;
+        /**
+         * Register a sound tag; registering the same path again returns the same ID
+         */
+        SoundId add_sound(std::string tag_path) noexcept;
+
+        /**
+         * Look up the registered sound tags and their permutation durations; call after every map load
+         */
+        void resolve_sounds() noexcept;
+        void clear_sounds() noexcept;
+        void enqueue_sound(SoundId sound, const SoundScheduling &scheduling = {}) noexcept;
+
+        /**
+         * Queue a sound by path, registering and resolving it first if needed
+         */
+        void enqueue_sound(const std::string &sound_tag_path, const SoundScheduling &scheduling = {}) noexcept;
+        void set_policy(const SoundQueuePolicy &policy) noexcept;
+        const SoundQueueStats &stats() const noexcept;
+
+        SoundPlaybackQueue(const Clock &clock) noexcept;
         ~SoundPlaybackQueue() noexcept;
-        void enqueue_sound(std::string sound_tag_path) noexcept;
+    };
+
+    struct MedalRender {
+        TimePoint creation_time;
+        const Medal *medal;
+        MedalSequence::Cursor medal_cursor = {};
+        MedalSequence::Cursor glow_cursor = {};
+    };
+
+    struct PendingMedal {
+        const Medal *medal;
+        TimePoint queued_time;
+    };
+
+    /**
+     * How the pending queue sheds load. Repeated pending medals up to coalesce_max_tier 
+     * are merged into the one already waiting, medals waiting longer than max_pending_age 
+     * are dropped (zero disables it) and medals from priority_min_tier up skip ahead of 
+     * lower tier ones.
+     */
+    struct RenderQueuePolicy {
+        std::uint8_t coalesce_max_tier = 0;
+        std::chrono::milliseconds max_pending_age = std::chrono::milliseconds(10000);
+        std::uint8_t priority_min_tier = 3;
+    };
+
+    struct RenderQueueStats {
+        std::size_t coalesced = 0;
+        std::size_t expired = 0;
+        std::size_t overflowed = 0;
     };
 
     class RenderQueue {
+    public:
+        static constexpr std::size_t max_renders_capacity = 8;
+        static constexpr std::size_t pending_capacity = 32;
+
     protected:
+        const Clock &m_clock;
         std::size_t m_max_renders;
-        std::deque<std::pair<TimePoint, const Medal *>> m_renders;
-        std::queue<const Medal *> m_queue;
+        RingBuffer<MedalRender, max_renders_capacity> m_renders;
+        RingBuffer<PendingMedal, pending_capacity> m_queue;
+        RenderQueuePolicy m_policy;
+        RenderQueueStats m_stats;
         Event::UIRenderEvent::ListenerHandle m_render_event_listener;
         Event::MapLoadEvent::ListenerHandle m_map_load_event_listener;
         
-        virtual void render() noexcept = 0;
+        void drop_stale_medals(TimePoint now) noexcept;
+        virtual void render(TimePoint now) noexcept = 0;
 
     public:
-        RenderQueue(std::size_t max_renders) noexcept;
+        RenderQueue(std::size_t max_renders, const Clock &clock) noexcept;
         ~RenderQueue() noexcept;
         void show_medal(const Medal *medal) noexcept;
+        void set_policy(const RenderQueuePolicy &policy) noexcept;
+        const RenderQueueStats &stats() const noexcept;
     };
 }
 
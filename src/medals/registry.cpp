@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../logger.hpp"
+#include "registry.hpp"
+
+namespace Raccoon::Medals {
+    MedalId MedalRegistry::add(Medal medal) noexcept {
+        auto hash = medal_name_hash(medal.name());
+        auto existing = m_ids.find(hash);
+        if(existing != m_ids.end()) {
+            auto id = existing->second;
+            if(m_medals[id].name() != medal.name()) {
+                logger.error("Medal name {} collides with {}", medal.name(), m_medals[id].name());
+                return MEDAL_ID_NONE;
+            }
+            medal.set_id(id);
+            m_medals[id] = std::move(medal);
+            return id;
+        }
+
+        if(m_medals.size() >= MEDAL_ID_NONE) {
+            logger.error("Too many medals; {} was not registered", medal.name());
+            return MEDAL_ID_NONE;
+        }
+
+        auto id = static_cast<MedalId>(m_medals.size());
+        medal.set_id(id);
+        m_medals.push_back(std::move(medal));
+        m_ids.emplace(hash, id);
+        return id;
+    }
+
+    MedalId MedalRegistry::find(std::uint32_t name_hash) const noexcept {
+        auto it = m_ids.find(name_hash);
+        return it != m_ids.end() ? it->second : MEDAL_ID_NONE;
+    }
+
+    MedalId MedalRegistry::find(std::string_view name) const noexcept {
+        auto id = find(medal_name_hash(name));
+        if(id != MEDAL_ID_NONE && m_medals[id].name() != name) {
+            return MEDAL_ID_NONE;
+        }
+        return id;
+    }
+
+    Medal *MedalRegistry::get(MedalId id) noexcept {
+        return id < m_medals.size() ? &m_medals[id] : nullptr;
+    }
+
+    const Medal *MedalRegistry::get(MedalId id) const noexcept {
+        return id < m_medals.size() ? &m_medals[id] : nullptr;
+    }
+
+    void MedalRegistry::clear() noexcept {
+        m_medals.clear();
+        m_ids.clear();
+    }
+}
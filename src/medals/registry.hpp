@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__REGISTRY_HPP
+#define RACCOON__MEDALS__REGISTRY_HPP
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <raccoon/medals.hpp>
+
+namespace Raccoon::Medals {
+    /**
+     * Owns the loaded medals and hands out dense IDs, which index the medals directly.
+     * Names are interned by hash, so looking a medal up by name is a single hash probe.
+     */
+    class MedalRegistry {
+    private:
+        std::vector<Medal> m_medals;
+        std::unordered_map<std::uint32_t, MedalId> m_ids;
+
+    public:
+        /**
+         * Register a medal; a medal with the same name replaces the registered one and keeps its ID
+         * @return the medal ID, or MEDAL_ID_NONE if its name hash collides with another medal
+         */
+        MedalId add(Medal medal) noexcept;
+        MedalId find(std::uint32_t name_hash) const noexcept;
+        MedalId find(std::string_view name) const noexcept;
+        Medal *get(MedalId id) noexcept;
+        const Medal *get(MedalId id) const noexcept;
+        void clear() noexcept;
+
+        std::size_t size() const noexcept {
+            return m_medals.size();
+        }
+
+        Medal &operator[](std::size_t index) noexcept {
+            return m_medals[index];
+        }
+
+        const Medal &operator[](std::size_t index) const noexcept {
+            return m_medals[index];
+        }
+
+        auto begin() noexcept {
+            return m_medals.begin();
+        }
+
+        auto end() noexcept {
+            return m_medals.end();
+        }
+
+        auto begin() const noexcept {
+            return m_medals.begin();
+        }
+
+        auto end() const noexcept {
+            return m_medals.end();
+        }
+    };
+}
+
+#endif
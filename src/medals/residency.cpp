@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include "residency.hpp"
+
+namespace Raccoon::Medals {
+    void TextureResidency::load(MedalId id, GameTick now) noexcept {
+        auto &entry = m_entries[id];
+        m_medals[id].load_bitmap_textures();
+        entry.resident = true;
+        entry.last_used = now;
+        m_stats.resident_medals++;
+        m_stats.resident_bytes += entry.bytes;
+        m_stats.loads++;
+    }
+
+    void TextureResidency::evict(MedalId id) noexcept {
+        auto &entry = m_entries[id];
+        m_medals[id].free_bitmap_textures();
+        entry.resident = false;
+        m_stats.resident_medals--;
+        m_stats.resident_bytes -= entry.bytes;
+    }
+
+    bool TextureResidency::make_room(std::size_t bytes, GameTick now) noexcept {
+        while(m_stats.resident_bytes + bytes > m_policy.max_bytes) {
+            std::size_t oldest = m_entries.size();
+            for(std::size_t i = 0; i < m_entries.size(); i++) {
+                auto &entry = m_entries[i];
+                if(!entry.resident || now - entry.last_used < m_policy.protect_ticks) {
+                    continue;
+                }
+                if(oldest == m_entries.size() || entry.last_used < m_entries[oldest].last_used) {
+                    oldest = i;
+                }
+            }
+            if(oldest == m_entries.size()) {
+                return false;
+            }
+            evict(static_cast<MedalId>(oldest));
+            m_stats.evictions++;
+        }
+        return true;
+    }
+
+    void TextureResidency::release() noexcept {
+        for(std::size_t i = 0; i < m_entries.size() && i < m_medals.size(); i++) {
+            if(m_entries[i].resident) {
+                evict(static_cast<MedalId>(i));
+            }
+        }
+    }
+
+    void TextureResidency::reset() noexcept {
+        release();
+        m_entries.assign(m_medals.size(), Entry());
+        m_stats.resident_medals = 0;
+        m_stats.resident_bytes = 0;
+        for(std::size_t i = 0; i < m_medals.size(); i++) {
+            m_entries[i].bytes = m_medals[i].bitmap_bytes();
+        }
+
+        // The most common medals are the lowest tier ones
+        m_prefetch_order.resize(m_medals.size());
+        for(std::size_t i = 0; i < m_prefetch_order.size(); i++) {
+            m_prefetch_order[i] = static_cast<MedalId>(i);
+        }
+        std::stable_sort(m_prefetch_order.begin(), m_prefetch_order.end(), [this](MedalId a, MedalId b) {
+            return m_medals[a].tier() < m_medals[b].tier();
+        });
+        m_prefetch_cursor = 0;
+    }
+
+    void TextureResidency::use(MedalId id, GameTick now) noexcept {
+        m_now = now;
+        if(id >= m_entries.size()) {
+            return;
+        }
+        auto &entry = m_entries[id];
+        entry.shown = true;
+        if(entry.resident) {
+            entry.last_used = now;
+            return;
+        }
+
+        // A medal about to be shown is loaded even if nothing can be evicted to make room for it
+        make_room(entry.bytes, now);
+        load(id, now);
+    }
+
+    void TextureResidency::prefetch(GameTick now) noexcept {
+        m_now = now;
+        if(m_policy.prefetch_budget.count() <= 0 || m_prefetch_cursor >= m_prefetch_order.size()) {
+            return;
+        }
+        auto deadline = std::chrono::steady_clock::now() + m_policy.prefetch_budget;
+        while(m_prefetch_cursor < m_prefetch_order.size() && std::chrono::steady_clock::now() < deadline) {
+            auto id = m_prefetch_order[m_prefetch_cursor];
+            auto &entry = m_entries[id];
+            if(entry.resident || entry.shown) {
+                m_prefetch_cursor++;
+                continue;
+            }
+
+            // Prefetching never evicts; the rest is loaded on first use
+            if(m_stats.resident_bytes + entry.bytes > m_policy.max_bytes) {
+                m_prefetch_cursor = m_prefetch_order.size();
+                return;
+            }
+
+            // Prefetched medals count as the least recently used
+            load(id, 0);
+            m_stats.prefetches++;
+            m_prefetch_cursor++;
+        }
+    }
+
+    void TextureResidency::set_policy(const TextureResidencyPolicy &policy) noexcept {
+        m_policy = policy;
+
+        // A lower cap applies right away, short of the medals that may still be on screen
+        make_room(0, m_now);
+    }
+
+    const TextureResidencyStats &TextureResidency::stats() const noexcept {
+        return m_stats;
+    }
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__RESIDENCY_HPP
+#define RACCOON__MEDALS__RESIDENCY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "clock.hpp"
+#include "registry.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * How medal textures are kept loaded. Medals stay resident up to max_bytes of pixel 
+     * data; past it the least recently shown ones are freed, except those shown in the 
+     * last protect_ticks, which may still be on screen. Medals that haven't been shown 
+     * yet are loaded ahead of time for up to prefetch_budget each tick (zero disables it).
+     */
+    struct TextureResidencyPolicy {
+        std::size_t max_bytes = 32 * 1024 * 1024;
+        std::chrono::microseconds prefetch_budget = std::chrono::microseconds(500);
+        GameTick protect_ticks = 15 * game_ticks_per_second;
+    };
+
+    struct TextureResidencyStats {
+        std::size_t resident_medals = 0;
+        std::size_t resident_bytes = 0;
+        std::size_t loads = 0;
+        std::size_t prefetches = 0;
+        std::size_t evictions = 0;
+    };
+
+    class TextureResidency {
+    private:
+        struct Entry {
+            std::size_t bytes = 0;
+            bool resident = false;
+            bool shown = false;
+            GameTick last_used = 0;
+        };
+
+        MedalRegistry &m_medals;
+        std::vector<Entry> m_entries;
+        std::vector<MedalId> m_prefetch_order;
+        std::size_t m_prefetch_cursor = 0;
+        TextureResidencyPolicy m_policy;
+        TextureResidencyStats m_stats;
+
+        /** Tick of the last use or prefetch, for evicting outside of them */
+        GameTick m_now = 0;
+
+        void load(MedalId id, GameTick now) noexcept;
+        void evict(MedalId id) noexcept;
+
+        /**
+         * Evict the least recently used medals until the bytes fit under the cap
+         * @return false if the unprotected medals aren't enough
+         */
+        bool make_room(std::size_t bytes, GameTick now) noexcept;
+
+    public:
+        /**
+         * Free every resident texture; call while the medal bitmaps are still the ones that were loaded
+         */
+        void release() noexcept;
+
+        /**
+         * Release what is resident and measure the medals again; call after their bitmap tags are reloaded
+         */
+        void reset() noexcept;
+
+        /**
+         * Load the textures of a medal about to be shown if they aren't resident yet
+         */
+        void use(MedalId id, GameTick now) noexcept;
+
+        /**
+         * Load medals that haven't been used yet, lowest tier first, within the time budget
+         */
+        void prefetch(GameTick now) noexcept;
+        void set_policy(const TextureResidencyPolicy &policy) noexcept;
+        const TextureResidencyStats &stats() const noexcept;
+
+        TextureResidency(MedalRegistry &medals) noexcept : m_medals(medals) {}
+    };
+}
+
+#endif
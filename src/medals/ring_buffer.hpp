@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__RING_BUFFER_HPP
+#define RACCOON__MEDALS__RING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace Raccoon::Medals {
+    /**
+     * Fixed-capacity double-ended queue over inline storage. It never allocates; pushes 
+     * fail when it is full. Inserting and erasing in the middle shift the elements in 
+     * between, which is cheap for the small capacities it is used with.
+     */
+    template<typename T, std::size_t N>
+    class RingBuffer {
+    private:
+        std::array<T, N> m_items = {};
+        std::size_t m_head = 0;
+        std::size_t m_size = 0;
+
+        std::size_t slot(std::size_t index) const noexcept {
+            return (m_head + index) % N;
+        }
+
+    public:
+        std::size_t size() const noexcept {
+            return m_size;
+        }
+
+        static constexpr std::size_t capacity() noexcept {
+            return N;
+        }
+
+        bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        bool full() const noexcept {
+            return m_size == N;
+        }
+
+        T &operator[](std::size_t index) noexcept {
+            return m_items[slot(index)];
+        }
+
+        const T &operator[](std::size_t index) const noexcept {
+            return m_items[slot(index)];
+        }
+
+        T &front() noexcept {
+            return m_items[m_head];
+        }
+
+        T &back() noexcept {
+            return m_items[slot(m_size - 1)];
+        }
+
+        bool push_back(const T &item) noexcept {
+            if(full()) {
+                return false;
+            }
+            m_items[slot(m_size)] = item;
+            m_size++;
+            return true;
+        }
+
+        bool push_front(const T &item) noexcept {
+            if(full()) {
+                return false;
+            }
+            m_head = (m_head + N - 1) % N;
+            m_items[m_head] = item;
+            m_size++;
+            return true;
+        }
+
+        void pop_front() noexcept {
+            if(!empty()) {
+                m_head = slot(1);
+                m_size--;
+            }
+        }
+
+        void pop_back() noexcept {
+            if(!empty()) {
+                m_size--;
+            }
+        }
+
+        bool insert(std::size_t index, const T &item) noexcept {
+            if(full() || index > m_size) {
+                return false;
+            }
+            push_back(item);
+            for(auto i = m_size - 1; i > index; i--) {
+                std::swap((*this)[i], (*this)[i - 1]);
+            }
+            return true;
+        }
+
+        void erase(std::size_t index) noexcept {
+            if(index >= m_size) {
+                return;
+            }
+            for(auto i = index; i + 1 < m_size; i++) {
+                (*this)[i] = std::move((*this)[i + 1]);
+            }
+            m_size--;
+        }
+
+        void clear() noexcept {
+            m_head = 0;
+            m_size = 0;
+        }
+    };
+}
+
+#endif
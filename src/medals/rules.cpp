@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "../logger.hpp"
+#include "rules.hpp"
+
+namespace Raccoon::Medals {
+    static constexpr std::array<const char *, MEDAL_RULE_TRIGGER_COUNT> trigger_names = {
+        "kill",
+        "killing_spree",
+        "multikill",
+        "from_the_grave",
+        "revenge",
+        "avenger",
+        "killjoy",
+        "flag_capture"
+    };
+
+    bool MedalRuleSet::add_rule(const MedalRuleDefinition &rule, const MedalNameResolver &resolve) noexcept {
+        auto medal = resolve(rule.medal);
+        if(medal == MEDAL_ID_NONE) {
+            logger.warning("Medal rule {} references unknown medal {}", trigger_names[rule.trigger], rule.medal);
+            return false;
+        }
+
+        auto window = milliseconds_to_game_ticks(rule.window);
+        auto set_table_entry = [&](std::vector<MedalId> &table) {
+            if(table.size() <= rule.threshold) {
+                table.resize(rule.threshold + 1, MEDAL_ID_NONE);
+            }
+            table[rule.threshold] = medal;
+        };
+
+        switch(rule.trigger) {
+            case MEDAL_RULE_TRIGGER_KILLING_SPREE:
+                set_table_entry(m_spree_medals);
+                break;
+            case MEDAL_RULE_TRIGGER_MULTIKILL:
+                set_table_entry(m_multikill_medals);
+                m_multikill_window = std::max(m_multikill_window, window);
+                break;
+            default:
+                m_rules[rule.trigger] = { medal, rule.threshold, window };
+                break;
+        }
+        return true;
+    }
+
+    void MedalRuleSet::compile(const MedalRuleDefinition *rules, std::size_t count, const MedalNameResolver &resolve) noexcept {
+        clear();
+        for(std::size_t i = 0; i < count; i++) {
+            add_rule(rules[i], resolve);
+        }
+    }
+
+    bool MedalRuleSet::load(std::istream &stream, const MedalNameResolver &resolve) noexcept {
+        clear();
+        bool ok = true;
+        std::string line;
+        std::size_t line_number = 0;
+        while(std::getline(stream, line)) {
+            line_number++;
+            std::istringstream tokens(line);
+            std::string trigger_name;
+            if(!(tokens >> trigger_name) || trigger_name[0] == '#') {
+                continue;
+            }
+
+            auto trigger = std::find_if(trigger_names.begin(), trigger_names.end(), [&](const char *name) {
+                return trigger_name == name;
+            });
+            std::uint32_t threshold;
+            long window;
+            std::string medal;
+            if(trigger == trigger_names.end() || !(tokens >> threshold >> window >> medal)) {
+                logger.warning("Malformed medal rule at line {}", line_number);
+                ok = false;
+                continue;
+            }
+
+            auto rule_trigger = static_cast<MedalRuleTrigger>(trigger - trigger_names.begin());
+            ok &= add_rule({ rule_trigger, threshold, std::chrono::milliseconds(window), medal.c_str() }, resolve);
+        }
+        return ok;
+    }
+
+    MedalId MedalRuleSet::trigger_medal(MedalRuleTrigger trigger) const noexcept {
+        switch(trigger) {
+            case MEDAL_RULE_TRIGGER_KILLING_SPREE:
+            case MEDAL_RULE_TRIGGER_MULTIKILL:
+                return MEDAL_ID_NONE;
+            default:
+                return m_rules[trigger].medal;
+        }
+    }
+
+    std::optional<MedalRuleMatch> MedalRuleSet::find_medal_rule(MedalId medal) const noexcept {
+        if(medal == MEDAL_ID_NONE) {
+            return std::nullopt;
+        }
+        for(std::uint32_t i = 0; i < m_spree_medals.size(); i++) {
+            if(m_spree_medals[i] == medal) {
+                return MedalRuleMatch { MEDAL_RULE_TRIGGER_KILLING_SPREE, i };
+            }
+        }
+        for(std::uint32_t i = 0; i < m_multikill_medals.size(); i++) {
+            if(m_multikill_medals[i] == medal) {
+                return MedalRuleMatch { MEDAL_RULE_TRIGGER_MULTIKILL, i };
+            }
+        }
+        for(std::size_t i = 0; i < m_rules.size(); i++) {
+            if(m_rules[i].medal == medal) {
+                return MedalRuleMatch { static_cast<MedalRuleTrigger>(i), m_rules[i].threshold };
+            }
+        }
+        return std::nullopt;
+    }
+
+    GameTick MedalRuleSet::multikill_window() const noexcept {
+        return m_multikill_window;
+    }
+
+    std::uint32_t MedalRuleSet::multikill_cap() const noexcept {
+        return m_multikill_medals.empty() ? 0 : static_cast<std::uint32_t>(m_multikill_medals.size() - 1);
+    }
+
+    void MedalRuleSet::evaluate(const MedalRuleFacts &facts, MedalRuleResults &results) const noexcept {
+        auto table_lookup = [](const std::vector<MedalId> &table, std::uint32_t count) {
+            return count < table.size() ? table[count] : MEDAL_ID_NONE;
+        };
+
+        // Every trigger writes its slot; the count only moves forward when it fired
+        results.count = 0;
+        auto emit = [&](MedalId medal, bool fired) {
+            results.medals[results.count] = medal;
+            results.count += fired && medal != MEDAL_ID_NONE;
+        };
+
+        auto &avenger = m_rules[MEDAL_RULE_TRIGGER_AVENGER];
+        auto &killjoy = m_rules[MEDAL_RULE_TRIGGER_KILLJOY];
+        emit(m_rules[MEDAL_RULE_TRIGGER_KILL].medal, facts.kill);
+        emit(table_lookup(m_spree_medals, facts.killing_spree), true);
+        emit(table_lookup(m_multikill_medals, facts.multikill), true);
+        emit(m_rules[MEDAL_RULE_TRIGGER_FROM_THE_GRAVE].medal, facts.killed_last_killer && facts.dead);
+        emit(m_rules[MEDAL_RULE_TRIGGER_REVENGE].medal, facts.killed_last_killer && !facts.dead);
+        emit(avenger.medal, facts.avenged_teammate && facts.avenge_elapsed <= avenger.window);
+        emit(killjoy.medal, facts.victim_multikill > 0 && facts.victim_multikill >= killjoy.threshold);
+        emit(m_rules[MEDAL_RULE_TRIGGER_FLAG_CAPTURE].medal, facts.flag_capture);
+    }
+
+    void MedalRuleSet::clear() noexcept {
+        m_spree_medals.clear();
+        m_multikill_medals.clear();
+        m_rules = {};
+        m_multikill_window = 0;
+    }
+}
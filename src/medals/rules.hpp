@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__RULES_HPP
+#define RACCOON__MEDALS__RULES_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <raccoon/medal_id.hpp>
+#include "clock.hpp"
+
+namespace Raccoon::Medals {
+    enum MedalRuleTrigger : std::uint8_t {
+        /** Any kill by the player; suppressed while the last medal shown was this one */
+        MEDAL_RULE_TRIGGER_KILL,
+        /** Kills since the last death reach the threshold */
+        MEDAL_RULE_TRIGGER_KILLING_SPREE,
+        /** Kills chained inside the window reach the threshold */
+        MEDAL_RULE_TRIGGER_MULTIKILL,
+        /** Killed the last killer while waiting to respawn */
+        MEDAL_RULE_TRIGGER_FROM_THE_GRAVE,
+        /** Killed the last killer while alive */
+        MEDAL_RULE_TRIGGER_REVENGE,
+        /** Killed an enemy within the window after they killed a teammate */
+        MEDAL_RULE_TRIGGER_AVENGER,
+        /** Ended an enemy multi-kill of at least the threshold */
+        MEDAL_RULE_TRIGGER_KILLJOY,
+        /** Captured the flag */
+        MEDAL_RULE_TRIGGER_FLAG_CAPTURE,
+        MEDAL_RULE_TRIGGER_COUNT
+    };
+
+    struct MedalRuleDefinition {
+        MedalRuleTrigger trigger;
+        std::uint32_t threshold;
+        std::chrono::milliseconds window;
+        const char *medal;
+    };
+
+    /**
+     * What happened in a HUD message, as seen by the rules
+     */
+    struct MedalRuleFacts {
+        bool kill = false;
+        std::uint32_t killing_spree = 0;
+        std::uint32_t multikill = 0;
+        bool killed_last_killer = false;
+        bool dead = false;
+        bool avenged_teammate = false;
+        GameTick avenge_elapsed = 0;
+        std::uint32_t victim_multikill = 0;
+        bool flag_capture = false;
+    };
+
+    struct MedalRuleResults {
+        static constexpr std::size_t capacity = MEDAL_RULE_TRIGGER_COUNT;
+        std::array<MedalId, capacity> medals;
+        std::size_t count = 0;
+    };
+
+    struct MedalRuleMatch {
+        MedalRuleTrigger trigger;
+        std::uint32_t threshold;
+    };
+
+    using MedalNameResolver = std::function<MedalId(std::string_view name)>;
+
+    /**
+     * Medal rules compiled into lookup tables of medal IDs. Spree and multi-kill
+     * thresholds index flat tables; every other trigger has a single slot. Windows
+     * are compiled into game ticks.
+     */
+    class MedalRuleSet {
+    private:
+        struct CompiledRule {
+            MedalId medal = MEDAL_ID_NONE;
+            std::uint32_t threshold = 0;
+            GameTick window = 0;
+        };
+
+        std::vector<MedalId> m_spree_medals;
+        std::vector<MedalId> m_multikill_medals;
+        std::array<CompiledRule, MEDAL_RULE_TRIGGER_COUNT> m_rules;
+        GameTick m_multikill_window = 0;
+
+    public:
+        /**
+         * Compile a rule into the tables; the medal name is resolved to its ID
+         * @return false if the medal doesn't exist
+         */
+        bool add_rule(const MedalRuleDefinition &rule, const MedalNameResolver &resolve) noexcept;
+        void compile(const MedalRuleDefinition *rules, std::size_t count, const MedalNameResolver &resolve) noexcept;
+
+        /**
+         * Parse rules, one per line: <trigger> <threshold> <window ms> <medal>. Lines starting with # are ignored.
+         * @return false if any line is malformed
+         */
+        bool load(std::istream &stream, const MedalNameResolver &resolve) noexcept;
+
+        MedalId trigger_medal(MedalRuleTrigger trigger) const noexcept;
+
+        /**
+         * Find the rule that awards a medal; spree and multi-kill rules are searched first
+         */
+        std::optional<MedalRuleMatch> find_medal_rule(MedalId medal) const noexcept;
+        GameTick multikill_window() const noexcept;
+        std::uint32_t multikill_cap() const noexcept;
+        void evaluate(const MedalRuleFacts &facts, MedalRuleResults &results) const noexcept;
+        void clear() noexcept;
+
+        template<std::size_t N>
+        void compile(const std::array<MedalRuleDefinition, N> &rules, const MedalNameResolver &resolve) noexcept {
+            compile(rules.data(), rules.size(), resolve);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <functional>
+#include "sprite_batch.hpp"
+
+namespace Raccoon::Medals {
+    void RecordingSpriteBackend::submit(const SpriteQuad *quads, std::size_t count) noexcept {
+        m_quads.insert(m_quads.end(), quads, quads + count);
+        m_submissions.push_back(count);
+    }
+
+    bool RecordingSpriteBackend::supports_atlas_pages() const noexcept {
+        return m_atlas_pages;
+    }
+
+    const std::vector<SpriteQuad> &RecordingSpriteBackend::quads() const noexcept {
+        return m_quads;
+    }
+
+    const std::vector<std::size_t> &RecordingSpriteBackend::submissions() const noexcept {
+        return m_submissions;
+    }
+
+    void RecordingSpriteBackend::clear() noexcept {
+        m_quads.clear();
+        m_submissions.clear();
+    }
+
+    void SpriteBatcher::add(const SpriteQuad &quad) noexcept {
+        auto &added = m_quads.emplace_back(quad);
+
+        // Grouping by atlas page only saves anything if the backend really draws from the pages
+        if(!m_backend || !m_backend->supports_atlas_pages()) {
+            added.atlas_page = SPRITE_NO_ATLAS_PAGE;
+            added.uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+        }
+    }
+
+    void SpriteBatcher::flush() noexcept {
+        m_last_submissions_count = 0;
+        if(m_quads.empty()) {
+            return;
+        }
+
+        // Layers keep their order; inside a layer quads are grouped by state and the draw order is kept otherwise
+        std::stable_sort(m_quads.begin(), m_quads.end(), [](const SpriteQuad &a, const SpriteQuad &b) {
+            if(a.layer != b.layer) {
+                return a.layer < b.layer;
+            }
+            if(a.blend_mode != b.blend_mode) {
+                return a.blend_mode < b.blend_mode;
+            }
+            if(a.atlas_page != b.atlas_page) {
+                return a.atlas_page < b.atlas_page;
+            }
+            if(a.atlas_page != SPRITE_NO_ATLAS_PAGE) {
+                return false;
+            }
+            return std::less<SpriteTexture>()(a.texture, b.texture);
+        });
+
+        auto same_batch = [](const SpriteQuad &a, const SpriteQuad &b) {
+            if(a.blend_mode != b.blend_mode || a.atlas_page != b.atlas_page) {
+                return false;
+            }
+            return a.atlas_page != SPRITE_NO_ATLAS_PAGE || a.texture == b.texture;
+        };
+
+        std::size_t batch_start = 0;
+        for(std::size_t i = 1; i <= m_quads.size(); i++) {
+            if(i == m_quads.size() || !same_batch(m_quads[batch_start], m_quads[i])) {
+                if(m_backend) {
+                    m_backend->submit(m_quads.data() + batch_start, i - batch_start);
+                }
+                m_last_submissions_count++;
+                batch_start = i;
+            }
+        }
+        m_quads.clear();
+    }
+
+    void SpriteBatcher::set_backend(SpriteBatchBackend *backend) noexcept {
+        m_backend = backend;
+    }
+
+    std::size_t SpriteBatcher::last_submissions_count() const noexcept {
+        return m_last_submissions_count;
+    }
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__SPRITE_BATCH_HPP
+#define RACCOON__MEDALS__SPRITE_BATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Balltze::Engine::TagDefinitions {
+    struct BitmapData;
+}
+
+namespace Raccoon::Medals {
+    using SpriteTexture = Balltze::Engine::TagDefinitions::BitmapData *;
+
+    enum SpriteBlendMode {
+        SPRITE_BLEND_MODE_ALPHA,
+        SPRITE_BLEND_MODE_ADDITIVE
+    };
+
+    struct SpriteVertex {
+        float x;
+        float y;
+    };
+
+    struct SpriteRect {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    struct SpriteColor {
+        std::uint8_t alpha;
+        std::uint8_t red;
+        std::uint8_t green;
+        std::uint8_t blue;
+    };
+
+    constexpr std::uint16_t SPRITE_NO_ATLAS_PAGE = 0xFFFF;
+
+    /**
+     * A quad to draw. Corners go clockwise from the top left one and rect is their 
+     * bounding box, for backends that can only draw axis-aligned rectangles. Quads 
+     * with an atlas page are batched by page and sample the given UV rectangle from 
+     * it if the backend supports atlas pages; the rest are batched by texture.
+     */
+    struct SpriteQuad {
+        SpriteTexture texture;
+        SpriteBlendMode blend_mode;
+        std::uint16_t layer;
+        std::uint16_t atlas_page = SPRITE_NO_ATLAS_PAGE;
+        SpriteRect uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+        std::array<SpriteVertex, 4> corners;
+        SpriteRect rect;
+        SpriteColor color;
+    };
+
+    /**
+     * Receives the batches of a frame. Every call is a single draw submission and all 
+     * of its quads share the same blend mode and texture or atlas page.
+     */
+    class SpriteBatchBackend {
+    public:
+        virtual void submit(const SpriteQuad *quads, std::size_t count) noexcept = 0;
+
+        /**
+         * Whether the backend can draw from atlas pages; quads sent to one that can't are batched by texture
+         */
+        virtual bool supports_atlas_pages() const noexcept {
+            return false;
+        }
+
+        virtual ~SpriteBatchBackend() = default;
+    };
+
+    /**
+     * Keeps every submission in memory instead of drawing it, so the batching can be 
+     * checked and timed without D3D9.
+     */
+    class RecordingSpriteBackend : public SpriteBatchBackend {
+    private:
+        std::vector<SpriteQuad> m_quads;
+        std::vector<std::size_t> m_submissions;
+        bool m_atlas_pages;
+
+    public:
+        void submit(const SpriteQuad *quads, std::size_t count) noexcept override;
+        bool supports_atlas_pages() const noexcept override;
+        const std::vector<SpriteQuad> &quads() const noexcept;
+        const std::vector<std::size_t> &submissions() const noexcept;
+        void clear() noexcept;
+        RecordingSpriteBackend(bool atlas_pages = false) noexcept : m_atlas_pages(atlas_pages) {}
+    };
+
+    class SpriteBatcher {
+    private:
+        SpriteBatchBackend *m_backend;
+        std::vector<SpriteQuad> m_quads;
+        std::size_t m_last_submissions_count = 0;
+
+    public:
+        void add(const SpriteQuad &quad) noexcept;
+        void flush() noexcept;
+        void set_backend(SpriteBatchBackend *backend) noexcept;
+        std::size_t last_submissions_count() const noexcept;
+        SpriteBatcher(SpriteBatchBackend *backend) noexcept : m_backend(backend) {}
+    };
+}
+
+#endif
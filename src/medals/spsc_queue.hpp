@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__SPSC_QUEUE_HPP
+#define RACCOON__MEDALS__SPSC_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Raccoon::Medals {
+    /**
+     * Lock-free queue for exactly one producer thread and one consumer thread, over 
+     * inline storage. Pushes fail instead of blocking when it is full. The indices only 
+     * grow; N must be a power of two so they wrap into slots cleanly.
+     */
+    template<typename T, std::size_t N>
+    class SpscQueue {
+    private:
+        static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+        std::array<T, N> m_items = {};
+        alignas(64) std::atomic<std::size_t> m_head = 0;
+        alignas(64) std::atomic<std::size_t> m_tail = 0;
+
+    public:
+        static constexpr std::size_t capacity() noexcept {
+            return N;
+        }
+
+        /**
+         * Producer side
+         * @return false if the queue is full
+         */
+        bool push(const T &item) noexcept {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+            if(tail - m_head.load(std::memory_order_acquire) == N) {
+                return false;
+            }
+            m_items[tail & (N - 1)] = item;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Consumer side; moves up to max items into items
+         * @return the number of items popped
+         */
+        std::size_t pop(T *items, std::size_t max) noexcept {
+            auto head = m_head.load(std::memory_order_relaxed);
+            auto count = std::min(m_tail.load(std::memory_order_acquire) - head, max);
+            for(std::size_t i = 0; i < count; i++) {
+                items[i] = m_items[(head + i) & (N - 1)];
+            }
+            m_head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        bool empty() const noexcept {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <cmath>
+#include "transform.hpp"
+
+namespace Raccoon::Medals {
+    SpriteVertex SpriteTransform::apply(float x, float y) const noexcept {
+        return { m00 * x + m01 * y + m02, m10 * x + m11 * y + m12 };
+    }
+
+    SpriteTransform SpriteTransform::make(float center_x, float center_y, float scale, float rotation) noexcept {
+        float sine = 0.0f;
+        float cosine = 1.0f;
+        if(rotation != 0.0f) {
+            sine = std::sin(rotation);
+            cosine = std::cos(rotation);
+        }
+        return { scale * cosine, -scale * sine, center_x, scale * sine, scale * cosine, center_y };
+    }
+
+    std::array<SpriteVertex, 4> transform_sprite_corners(const SpriteTransform &transform, float width, float height) noexcept {
+        auto half_width = width / 2;
+        auto half_height = height / 2;
+        return {{
+            transform.apply(-half_width, -half_height),
+            transform.apply(half_width, -half_height),
+            transform.apply(half_width, half_height),
+            transform.apply(-half_width, half_height)
+        }};
+    }
+
+    SpriteRect sprite_corners_bounds(const std::array<SpriteVertex, 4> &corners) noexcept {
+        SpriteRect bounds = { corners[0].x, corners[0].y, corners[0].x, corners[0].y };
+        for(auto &corner : corners) {
+            bounds.left = std::min(bounds.left, corner.x);
+            bounds.top = std::min(bounds.top, corner.y);
+            bounds.right = std::max(bounds.right, corner.x);
+            bounds.bottom = std::max(bounds.bottom, corner.y);
+        }
+        return bounds;
+    }
+
+    std::size_t SpriteTransformBatch::size() const noexcept {
+        return center_x.size();
+    }
+
+    void SpriteTransformBatch::clear() noexcept {
+        for(auto *buffer : { &center_x, &center_y, &width, &height, &scale, &rotation }) {
+            buffer->clear();
+        }
+        corners.clear();
+    }
+
+    std::size_t SpriteTransformBatch::push(float x, float y, float sprite_width, float sprite_height, float sprite_scale, float sprite_rotation) noexcept {
+        center_x.push_back(x);
+        center_y.push_back(y);
+        width.push_back(sprite_width);
+        height.push_back(sprite_height);
+        scale.push_back(sprite_scale);
+        rotation.push_back(sprite_rotation);
+        return size() - 1;
+    }
+
+    void SpriteTransformBatch::transform() noexcept {
+        auto count = size();
+        corners.resize(count);
+        for(std::size_t i = 0; i < count; i++) {
+            auto transform = SpriteTransform::make(center_x[i], center_y[i], scale[i], rotation[i]);
+            corners[i] = transform_sprite_corners(transform, width[i], height[i]);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__MEDALS__TRANSFORM_HPP
+#define RACCOON__MEDALS__TRANSFORM_HPP
+
+#include <array>
+#include <vector>
+#include "sprite_batch.hpp"
+
+namespace Raccoon::Medals {
+    /**
+     * 2x3 affine matrix mapping sprite local coordinates (origin at the sprite center) 
+     * to screen coordinates.
+     */
+    struct SpriteTransform {
+        float m00;
+        float m01;
+        float m02;
+        float m10;
+        float m11;
+        float m12;
+
+        SpriteVertex apply(float x, float y) const noexcept;
+        static SpriteTransform make(float center_x, float center_y, float scale, float rotation) noexcept;
+    };
+
+    std::array<SpriteVertex, 4> transform_sprite_corners(const SpriteTransform &transform, float width, float height) noexcept;
+    SpriteRect sprite_corners_bounds(const std::array<SpriteVertex, 4> &corners) noexcept;
+
+    /**
+     * Sprites of a frame as structure of arrays, positioned by their centers; 
+     * transform() builds every matrix and its four corners in a single pass.
+     */
+    struct SpriteTransformBatch {
+        std::vector<float> center_x;
+        std::vector<float> center_y;
+        std::vector<float> width;
+        std::vector<float> height;
+        std::vector<float> scale;
+        std::vector<float> rotation;
+        std::vector<std::array<SpriteVertex, 4>> corners;
+
+        std::size_t size() const noexcept;
+        void clear() noexcept;
+        std::size_t push(float x, float y, float sprite_width, float sprite_height, float sprite_scale, float sprite_rotation) noexcept;
+        void transform() noexcept;
+    };
+}
+
+#endif
@@ -12,6 +12,8 @@
 #include <balltze/memory.hpp>
 #include <balltze/hook.hpp>
 #include "../logger.hpp"
+#include "../profiling/counters.hpp"
+#include "../profiling/trace.hpp"
 #include "../resources.hpp"
 
 using namespace Balltze;
@@ -60,6 +62,7 @@ namespace Raccoon::PostProcess {
     }
 
     static void apply_pixelate_postprocess() {
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_PIXELATE_PASS);
         auto &backbuffer = render_targets[0];
         pixelate_sprite.update_texture(pixelate_render_target_texture);
         pixelate_sprite.begin();
@@ -69,6 +72,7 @@ namespace Raccoon::PostProcess {
     }
 
     static void draw_pixelate_frame() {
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_PIXELATE_PRESENT);
         auto &backbuffer = render_targets[0];
         device->SetRenderTarget(0, backbuffer_surface);
         pixelate_sprite.update_texture(pixelate_render_target_texture);
@@ -81,6 +85,8 @@ namespace Raccoon::PostProcess {
         if(event.time == Event::EVENT_TIME_AFTER) {
             return;
         }
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_PIXELATE_BEGIN_SCENE);
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_PIXELATE_BEGIN_SCENE);
 
         device = event.context.device;
         if(!device) {
@@ -105,6 +111,8 @@ namespace Raccoon::PostProcess {
         if(event.time == Event::EVENT_TIME_AFTER || !device) {
             return;
         }
+        RACCOON_PROFILE_SCOPE(PROFILE_SECTION_PIXELATE_END_SCENE);
+        Profiling::TraceSpan trace_span(Profiling::TRACE_EVENT_PIXELATE_END_SCENE);
 
         // Apply the pixelate post process to the render target texture
         apply_pixelate_postprocess();
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include "counters.hpp"
+
+namespace Raccoon::Profiling {
+    const char *profile_section_name(ProfileSection section) noexcept {
+        switch(section) {
+            case PROFILE_SECTION_H4_RENDER:
+                return "h4_render";
+            case PROFILE_SECTION_MEDAL_DRAW:
+                return "medal_draw";
+            case PROFILE_SECTION_DISPATCH_MEDALS:
+                return "dispatch_medals";
+            case PROFILE_SECTION_SOUND_QUEUE_TICK:
+                return "sound_queue_tick";
+            case PROFILE_SECTION_UPDATE_MEDALS_TAG_REFERENCES:
+                return "update_medals_tag_references";
+            case PROFILE_SECTION_PIXELATE_BEGIN_SCENE:
+                return "pixelate_begin_scene";
+            case PROFILE_SECTION_PIXELATE_END_SCENE:
+                return "pixelate_end_scene";
+            default:
+                return "unknown";
+        }
+    }
+
+    std::size_t LatencyHistogram::bucket_for(std::uint64_t nanoseconds) noexcept {
+        if(nanoseconds < sub_buckets) {
+            return nanoseconds;
+        }
+        // Values in [2^n, 2^(n+1)) share four buckets, split on the two bits below the top one
+        std::size_t top_bit = 63 - __builtin_clzll(nanoseconds);
+        std::size_t sub_bucket = (nanoseconds >> (top_bit - 2)) & (sub_buckets - 1);
+        return std::min(sub_buckets + (top_bit - 2) * sub_buckets + sub_bucket, buckets_count - 1);
+    }
+
+    std::uint64_t LatencyHistogram::bucket_upper_bound(std::size_t bucket) noexcept {
+        if(bucket < sub_buckets) {
+            return bucket;
+        }
+        std::size_t shift = (bucket - sub_buckets) / sub_buckets;
+        std::uint64_t lower = static_cast<std::uint64_t>(sub_buckets + (bucket - sub_buckets) % sub_buckets) << shift;
+        return lower + (std::uint64_t(1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(std::uint64_t nanoseconds) noexcept {
+        m_buckets[bucket_for(nanoseconds)]++;
+        m_count++;
+        m_max = std::max(m_max, nanoseconds);
+    }
+
+    std::uint64_t LatencyHistogram::percentile(double percentile) const noexcept {
+        if(m_count == 0) {
+            return 0;
+        }
+        auto target = static_cast<std::uint64_t>(percentile / 100.0 * m_count);
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < m_buckets.size(); i++) {
+            seen += m_buckets[i];
+            if(seen > target) {
+                return std::min(bucket_upper_bound(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    std::uint64_t LatencyHistogram::max() const noexcept {
+        return m_max;
+    }
+
+    std::uint64_t LatencyHistogram::count() const noexcept {
+        return m_count;
+    }
+
+    void LatencyHistogram::reset() noexcept {
+        m_buckets = {};
+        m_count = 0;
+        m_max = 0;
+    }
+
+    static std::array<LatencyHistogram, PROFILE_SECTION_COUNT> histograms;
+
+    LatencyHistogram &profile_histogram(ProfileSection section) noexcept {
+        return histograms[section];
+    }
+
+    void reset_profile_histograms() noexcept {
+        for(auto &histogram : histograms) {
+            histogram.reset();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__PROFILING__COUNTERS_HPP
+#define RACCOON__PROFILING__COUNTERS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Raccoon::Profiling {
+    enum ProfileSection : std::uint8_t {
+        PROFILE_SECTION_H4_RENDER,
+        PROFILE_SECTION_MEDAL_DRAW,
+        PROFILE_SECTION_DISPATCH_MEDALS,
+        PROFILE_SECTION_SOUND_QUEUE_TICK,
+        PROFILE_SECTION_UPDATE_MEDALS_TAG_REFERENCES,
+        PROFILE_SECTION_PIXELATE_BEGIN_SCENE,
+        PROFILE_SECTION_PIXELATE_END_SCENE,
+        PROFILE_SECTION_COUNT
+    };
+
+    const char *profile_section_name(ProfileSection section) noexcept;
+
+    /**
+     * Latency histogram over fixed log-linear buckets: each power of two of nanoseconds
+     * is split into four, so a percentile is known to within 25%. The maximum is exact.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr std::size_t sub_buckets = 4;
+        static constexpr std::size_t buckets_count = 256;
+
+    private:
+        std::array<std::uint32_t, buckets_count> m_buckets = {};
+        std::uint64_t m_count = 0;
+        std::uint64_t m_max = 0;
+
+        static std::size_t bucket_for(std::uint64_t nanoseconds) noexcept;
+        static std::uint64_t bucket_upper_bound(std::size_t bucket) noexcept;
+
+    public:
+        void record(std::uint64_t nanoseconds) noexcept;
+
+        /**
+         * @return the upper bound of the bucket holding the percentile, in nanoseconds
+         */
+        std::uint64_t percentile(double percentile) const noexcept;
+        std::uint64_t max() const noexcept;
+        std::uint64_t count() const noexcept;
+        void reset() noexcept;
+    };
+
+    /**
+     * Histograms of every section. Sections are only timed on the game thread, so 
+     * recording is not synchronized.
+     */
+    LatencyHistogram &profile_histogram(ProfileSection section) noexcept;
+    void reset_profile_histograms() noexcept;
+
+    class ScopedTimer {
+    private:
+        ProfileSection m_section;
+        std::chrono::steady_clock::time_point m_start;
+
+    public:
+        ScopedTimer(ProfileSection section) noexcept : m_section(section), m_start(std::chrono::steady_clock::now()) {}
+
+        ~ScopedTimer() noexcept {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+            profile_histogram(m_section).record(elapsed.count());
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+}
+
+#define RACCOON_PROFILE_CONCAT_INNER(a, b) a##b
+#define RACCOON_PROFILE_CONCAT(a, b) RACCOON_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Time the rest of the enclosing scope; expands to nothing unless RACCOON_PROFILING is defined
+ */
+#ifdef RACCOON_PROFILING
+#define RACCOON_PROFILE_SCOPE(section) ::Raccoon::Profiling::ScopedTimer RACCOON_PROFILE_CONCAT(raccoon_profile_timer_, __LINE__)(::Raccoon::Profiling::section)
+#else
+#define RACCOON_PROFILE_SCOPE(section) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+#include "trace.hpp"
+
+namespace Raccoon::Profiling {
+    const char *trace_event_name(TraceEventName name) noexcept {
+        switch(name) {
+            case TRACE_EVENT_MEDAL_DISPATCH:
+                return "medal_dispatch";
+            case TRACE_EVENT_RENDER_QUEUE_PUSH:
+                return "render_queue_push";
+            case TRACE_EVENT_RENDER_QUEUE_POP:
+                return "render_queue_pop";
+            case TRACE_EVENT_SOUND_QUEUE_PUSH:
+                return "sound_queue_push";
+            case TRACE_EVENT_SOUND_QUEUE_POP:
+                return "sound_queue_pop";
+            case TRACE_EVENT_SOUND_START:
+                return "sound_start";
+            case TRACE_EVENT_TEXTURE_RELOAD:
+                return "texture_reload";
+            case TRACE_EVENT_PIXELATE_BEGIN_SCENE:
+                return "pixelate_begin_scene";
+            case TRACE_EVENT_PIXELATE_END_SCENE:
+                return "pixelate_end_scene";
+            case TRACE_EVENT_PIXELATE_PASS:
+                return "pixelate_pass";
+            case TRACE_EVENT_PIXELATE_PRESENT:
+                return "pixelate_present";
+            default:
+                return "unknown";
+        }
+    }
+
+    void TraceRecorder::record(const TraceRecord &record) noexcept {
+        auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+        auto &slot = m_slots[index & (capacity - 1)];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.record = record;
+        slot.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    std::size_t TraceRecorder::write_chrome_trace(std::ostream &stream, std::chrono::nanoseconds window) const {
+        auto now = trace_timestamp();
+        auto window_start = now > static_cast<std::uint64_t>(window.count()) ? now - window.count() : 0;
+
+        std::vector<TraceRecord> records;
+        records.reserve(capacity);
+        for(auto &slot : m_slots) {
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if(sequence == 0) {
+                continue;
+            }
+            auto record = slot.record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+            if(record.timestamp + record.duration >= window_start) {
+                records.push_back(record);
+            }
+        }
+        std::sort(records.begin(), records.end(), [](const TraceRecord &a, const TraceRecord &b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        // Chrome wants microseconds; keep them relative to the first record so they stay readable
+        auto origin = records.empty() ? 0 : records.front().timestamp;
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for(std::size_t i = 0; i < records.size(); i++) {
+            auto &[timestamp, duration, argument, thread, name, span] = records[i];
+            stream << (i > 0 ? ",\n" : "\n");
+            stream << "{\"name\":\"" << trace_event_name(name) << "\",\"cat\":\"raccoon\",\"pid\":1,\"tid\":" << thread;
+            stream << ",\"ts\":" << (timestamp - origin) / 1000.0;
+            if(span) {
+                stream << ",\"ph\":\"X\",\"dur\":" << duration / 1000.0;
+            }
+            else {
+                stream << ",\"ph\":\"i\",\"s\":\"t\"";
+            }
+            stream << ",\"args\":{\"value\":" << argument << "}}";
+        }
+        stream << "\n]}\n";
+        return records.size();
+    }
+
+    static TraceRecorder recorder;
+
+    TraceRecorder &trace_recorder() noexcept {
+        return recorder;
+    }
+
+    std::uint64_t trace_timestamp() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static std::uint16_t trace_thread() noexcept {
+        static std::atomic<std::uint16_t> next_thread = 1;
+        thread_local std::uint16_t thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return thread;
+    }
+
+    void trace_instant(TraceEventName name, std::uint32_t argument) noexcept {
+        recorder.record({ .timestamp = trace_timestamp(), .duration = 0, .argument = argument, .thread = trace_thread(), .name = name, .span = false });
+    }
+
+    TraceSpan::~TraceSpan() noexcept {
+        auto end = trace_timestamp();
+        recorder.record({ .timestamp = m_start, .duration = end - m_start, .argument = m_argument, .thread = trace_thread(), .name = m_name, .span = true });
+    }
+}
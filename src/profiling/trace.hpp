@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__PROFILING__TRACE_HPP
+#define RACCOON__PROFILING__TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace Raccoon::Profiling {
+    enum TraceEventName : std::uint8_t {
+        TRACE_EVENT_MEDAL_DISPATCH,
+        TRACE_EVENT_RENDER_QUEUE_PUSH,
+        TRACE_EVENT_RENDER_QUEUE_POP,
+        TRACE_EVENT_SOUND_QUEUE_PUSH,
+        TRACE_EVENT_SOUND_QUEUE_POP,
+        TRACE_EVENT_SOUND_START,
+        TRACE_EVENT_TEXTURE_RELOAD,
+        TRACE_EVENT_PIXELATE_BEGIN_SCENE,
+        TRACE_EVENT_PIXELATE_END_SCENE,
+        TRACE_EVENT_PIXELATE_PASS,
+        TRACE_EVENT_PIXELATE_PRESENT,
+        TRACE_EVENT_COUNT
+    };
+
+    const char *trace_event_name(TraceEventName name) noexcept;
+
+    struct TraceRecord {
+        /** Steady clock nanoseconds */
+        std::uint64_t timestamp = 0;
+        /** Zero for instant events */
+        std::uint64_t duration = 0;
+        std::uint32_t argument = 0;
+        std::uint16_t thread = 0;
+        TraceEventName name = TRACE_EVENT_COUNT;
+        bool span = false;
+    };
+
+    /**
+     * Flight recorder: a fixed ring of the latest trace records, overwritten oldest first.
+     * Any thread may record without locking or allocating; each slot carries a sequence
+     * number so a dump skips slots that are being overwritten while it reads them.
+     */
+    class TraceRecorder {
+    public:
+        static constexpr std::size_t capacity = 8192;
+
+    private:
+        static_assert((capacity & (capacity - 1)) == 0, "TraceRecorder capacity must be a power of two");
+
+        struct Slot {
+            /** Index of the record plus one once written; zero while empty or being written */
+            std::atomic<std::uint64_t> sequence = 0;
+            TraceRecord record;
+        };
+
+        std::array<Slot, capacity> m_slots;
+        std::atomic<std::uint64_t> m_next = 0;
+
+    public:
+        void record(const TraceRecord &record) noexcept;
+
+        /**
+         * Write the records from the last window as Chrome trace_event JSON
+         * @return the number of records written
+         */
+        std::size_t write_chrome_trace(std::ostream &stream, std::chrono::nanoseconds window) const;
+    };
+
+    TraceRecorder &trace_recorder() noexcept;
+    std::uint64_t trace_timestamp() noexcept;
+    void trace_instant(TraceEventName name, std::uint32_t argument = 0) noexcept;
+
+    /**
+     * Records a span from construction to destruction
+     */
+    class TraceSpan {
+    private:
+        TraceEventName m_name;
+        std::uint32_t m_argument;
+        std::uint64_t m_start;
+
+    public:
+        TraceSpan(TraceEventName name, std::uint32_t argument = 0) noexcept : m_name(name), m_argument(argument), m_start(trace_timestamp()) {}
+        ~TraceSpan() noexcept;
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+    };
+}
+
+#endif
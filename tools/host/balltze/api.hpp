@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__API_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__API_HPP
+
+#include "engine/tag.hpp"
+#include "engine/user_interface.hpp"
+#include "events/render.hpp"
+#include "plugin.hpp"
+
+#endif
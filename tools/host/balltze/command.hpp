@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__COMMAND_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__COMMAND_HPP
+
+#include <cstddef>
+#include <optional>
+
+namespace Balltze {
+    using CommandFunction = bool (*)(int argc, const char **argv);
+
+    bool register_command(const char *name, const char *category, const char *help, std::optional<const char *> params_help, CommandFunction function, bool autosave, std::size_t min_args, std::size_t max_args, bool can_call_from_console = true, bool is_public = false);
+}
+
+#endif
@@ -0,0 +1,6 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__CONFIG_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__CONFIG_HPP
+
+#endif
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__DATA_TYPES_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__DATA_TYPES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Balltze::Engine {
+    using Point = float;
+
+    struct Point2D {
+        Point x;
+        Point y;
+
+        Point2D operator+(const Point2D &other) const noexcept {
+            return { x + other.x, y + other.y };
+        }
+    };
+
+    struct ColorARGBInt {
+        std::uint8_t alpha;
+        std::uint8_t red;
+        std::uint8_t green;
+        std::uint8_t blue;
+    };
+
+    struct Rectangle2D {
+        std::int16_t top;
+        std::int16_t left;
+        std::int16_t bottom;
+        std::int16_t right;
+    };
+
+    union TableResourceHandle {
+        std::uint32_t value;
+        struct {
+            std::uint16_t index;
+            std::uint16_t id;
+        };
+
+        TableResourceHandle() noexcept : value(0xFFFFFFFF) {}
+        TableResourceHandle(std::uint32_t value) noexcept : value(value) {}
+
+        static TableResourceHandle null() noexcept {
+            return 0xFFFFFFFF;
+        }
+
+        bool is_null() const noexcept {
+            return value == 0xFFFFFFFF;
+        }
+
+        bool operator==(const TableResourceHandle &other) const noexcept {
+            return value == other.value;
+        }
+
+        bool operator!=(const TableResourceHandle &other) const noexcept {
+            return value != other.value;
+        }
+
+        bool operator<(const TableResourceHandle &other) const noexcept {
+            return value < other.value;
+        }
+    };
+
+    using PlayerHandle = TableResourceHandle;
+    using TagHandle = TableResourceHandle;
+
+    enum TagClassInt : std::uint32_t {
+        TAG_CLASS_BITMAP = 0x6269746D,
+        TAG_CLASS_SOUND = 0x736E6421,
+        TAG_CLASS_TAG_COLLECTION = 0x74616763
+    };
+
+    template<typename T>
+    struct TagBlock {
+        std::uint32_t count;
+        T *elements;
+        void *definition;
+    };
+
+    struct TagReference {
+        TagClassInt tag_class;
+        const char *path;
+        std::size_t path_size;
+        TagHandle tag_handle;
+    };
+
+    struct Tag {
+        TagClassInt primary_class;
+        TagHandle handle;
+        char *path;
+        std::byte *data;
+    };
+
+    enum NetworkGameMultiplayerHudMessage {
+        HUD_MESSAGE_LOCAL_KILLED_PLAYER,
+        HUD_MESSAGE_SUICIDE,
+        HUD_MESSAGE_LOCAL_CTF_SCORE,
+        HUD_MESSAGE_LOCAL_DOUBLE_KILL,
+        HUD_MESSAGE_LOCAL_TRIPLE_KILL,
+        HUD_MESSAGE_LOCAL_KILLING_SPREE,
+        HUD_MESSAGE_LOCAL_KILLTACULAR,
+        HUD_MESSAGE_LOCAL_RUNNING_RIOT
+    };
+
+    enum NetworkGameMultiplayerSound {
+        MULTIPLAYER_SOUND_DOUBLE_KILL,
+        MULTIPLAYER_SOUND_TRIPLE_KILL,
+        MULTIPLAYER_SOUND_KILLTACULAR,
+        MULTIPLAYER_SOUND_RUNNING_RIOT,
+        MULTIPLAYER_SOUND_KILLING_SPREE
+    };
+
+    struct Player {
+        std::uint32_t team;
+        std::int32_t respawn_time;
+    };
+
+    class PlayerTable {
+    public:
+        Player *get_player(PlayerHandle handle) noexcept;
+        Player *get_client_player() noexcept;
+    };
+
+    Tag *get_tag(std::string path, TagClassInt tag_class) noexcept;
+    Tag *get_tag(TagHandle handle) noexcept;
+    PlayerTable &get_player_table() noexcept;
+    bool network_game_current_game_is_team() noexcept;
+}
+
+#endif
@@ -0,0 +1,8 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_HPP
+
+#include "data_types.hpp"
+
+#endif
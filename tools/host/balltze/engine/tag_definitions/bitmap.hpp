@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__BITMAP_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__BITMAP_HPP
+
+#include "../data_types.hpp"
+
+namespace Balltze::Engine::TagDefinitions {
+    struct BitmapData {
+        std::uint16_t width;
+        std::uint16_t height;
+        std::uint32_t pixel_data_size;
+    };
+
+    struct Bitmap {
+        TagBlock<BitmapData> bitmap_data;
+    };
+}
+
+#endif
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__SOUND_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__SOUND_HPP
+
+#include "../data_types.hpp"
+
+namespace Balltze::Engine::TagDefinitions {
+    struct SoundPermutation {
+        std::uint32_t samples_duration_ms;
+    };
+
+    struct SoundPitchRange {
+        TagBlock<SoundPermutation> permutations;
+        std::uint16_t actual_permutation_count;
+    };
+
+    struct Sound {
+        TagBlock<SoundPitchRange> pitch_ranges;
+    };
+}
+
+#endif
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__TAG_COLLECTION_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__TAG_DEFINITIONS__TAG_COLLECTION_HPP
+
+#include "../data_types.hpp"
+
+namespace Balltze::Engine::TagDefinitions {
+    struct TagCollectionTag {
+        TagReference reference;
+    };
+
+    struct TagCollection {
+        TagBlock<TagCollectionTag> tags;
+    };
+}
+
+#endif
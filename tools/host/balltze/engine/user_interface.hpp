@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__ENGINE__USER_INTERFACE_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__ENGINE__USER_INTERFACE_HPP
+
+#include <chrono>
+#include "tag_definitions/bitmap.hpp"
+#include "tag_definitions/sound.hpp"
+
+namespace Balltze::Engine {
+    void draw_bitmap_in_rect(TagDefinitions::BitmapData *bitmap, Rectangle2D rect, ColorARGBInt color) noexcept;
+    void load_bitmap_data_texture(TagDefinitions::BitmapData *bitmap, bool immediately, bool really) noexcept;
+    void free_bitmap_data_texture(TagDefinitions::BitmapData *bitmap) noexcept;
+    void play_sound(TagHandle tag) noexcept;
+    std::chrono::milliseconds get_sound_permutation_samples_duration(TagDefinitions::SoundPermutation *permutation) noexcept;
+}
+
+#endif
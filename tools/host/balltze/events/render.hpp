@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__EVENTS__RENDER_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__EVENTS__RENDER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../engine/tag_definitions/sound.hpp"
+
+/**
+ * The stand-in declares every event the medals use here. Unlike Balltze, events are 
+ * dispatched by the host program itself by constructing them and calling dispatch().
+ */
+namespace Balltze::Event {
+    enum EventTime {
+        EVENT_TIME_BEFORE,
+        EVENT_TIME_AFTER
+    };
+
+    enum EventPriority {
+        EVENT_PRIORITY_LOWEST,
+        EVENT_PRIORITY_DEFAULT,
+        EVENT_PRIORITY_HIGHEST
+    };
+
+    template<typename T>
+    class EventListenerHandle {
+    private:
+        std::size_t m_id = 0;
+
+    public:
+        void remove() noexcept {
+            T::unsubscribe(m_id);
+            m_id = 0;
+        }
+
+        EventListenerHandle() noexcept = default;
+        EventListenerHandle(std::size_t id) noexcept : m_id(id) {}
+    };
+
+    template<typename T, typename Context>
+    class EventBase {
+    private:
+        struct Listener {
+            std::size_t id;
+            EventPriority priority;
+            std::function<void(T &)> callback;
+        };
+
+        static inline std::vector<Listener> listeners;
+        static inline std::size_t next_listener_id = 1;
+        bool m_cancelled = false;
+
+    public:
+        using ListenerHandle = EventListenerHandle<T>;
+
+        EventTime time;
+        Context context;
+
+        void cancel() noexcept {
+            m_cancelled = true;
+        }
+
+        bool cancelled() const noexcept {
+            return m_cancelled;
+        }
+
+        void dispatch() {
+            // Copied so listeners can subscribe or unsubscribe while being called
+            auto current_listeners = listeners;
+            for(auto &listener : current_listeners) {
+                listener.callback(static_cast<T &>(*this));
+            }
+        }
+
+        static ListenerHandle subscribe(std::function<void(T &)> callback, EventPriority priority = EVENT_PRIORITY_DEFAULT) {
+            auto id = next_listener_id++;
+            auto it = std::find_if(listeners.begin(), listeners.end(), [&](const Listener &listener) {
+                return listener.priority < priority;
+            });
+            listeners.insert(it, { id, priority, std::move(callback) });
+            return id;
+        }
+
+        static ListenerHandle subscribe_const(std::function<void(const T &)> callback, EventPriority priority = EVENT_PRIORITY_DEFAULT) {
+            return subscribe([callback = std::move(callback)](T &event) {
+                callback(event);
+            }, priority);
+        }
+
+        static void unsubscribe(std::size_t id) noexcept {
+            listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [&](const Listener &listener) {
+                return listener.id == id;
+            }), listeners.end());
+        }
+
+        EventBase(EventTime time, Context context) : time(time), context(std::move(context)) {}
+    };
+
+    struct UIRenderEventContext {};
+
+    struct UIRenderEvent : EventBase<UIRenderEvent, UIRenderEventContext> {
+        using EventBase::EventBase;
+    };
+
+    struct MapLoadEventContext {
+        std::string name;
+    };
+
+    struct MapLoadEvent : EventBase<MapLoadEvent, MapLoadEventContext> {
+        using EventBase::EventBase;
+    };
+
+    struct TickEventContext {
+        std::size_t tick_count;
+    };
+
+    struct TickEvent : EventBase<TickEvent, TickEventContext> {
+        using EventBase::EventBase;
+    };
+
+    struct SoundPlaybackEventContext {
+        Engine::TagDefinitions::Sound *sound;
+        Engine::TagDefinitions::SoundPermutation *permutation;
+    };
+
+    struct SoundPlaybackEvent : EventBase<SoundPlaybackEvent, SoundPlaybackEventContext> {
+        using EventBase::EventBase;
+    };
+
+    struct NetworkGameHudMessageEventContext {
+        Engine::NetworkGameMultiplayerHudMessage message_type;
+        Engine::PlayerHandle causer;
+        Engine::PlayerHandle victim;
+        Engine::PlayerHandle local_player;
+    };
+
+    struct NetworkGameHudMessageEvent : EventBase<NetworkGameHudMessageEvent, NetworkGameHudMessageEventContext> {
+        using EventBase::EventBase;
+    };
+
+    struct NetworkGameMultiplayerSoundEventContext {
+        Engine::NetworkGameMultiplayerSound sound;
+    };
+
+    struct NetworkGameMultiplayerSoundEvent : EventBase<NetworkGameMultiplayerSoundEvent, NetworkGameMultiplayerSoundEventContext> {
+        using EventBase::EventBase;
+    };
+}
+
+#endif
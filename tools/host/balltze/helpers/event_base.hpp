@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+// Included inside the namespace of the events it declares, like the Balltze helper
+
+enum EventTime {
+    EVENT_TIME_BEFORE,
+    EVENT_TIME_AFTER
+};
+
+template<typename T>
+class EventHandler {};
+
+template<typename T>
+class EventData {
+public:
+    EventTime time;
+
+    void dispatch() {}
+
+    EventData(EventTime time) : time(time) {}
+};
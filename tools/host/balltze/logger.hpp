@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__LOGGER_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__LOGGER_HPP
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace Balltze {
+    /**
+     * Host stand-in for the Balltze logger; formats {} placeholders and writes to stderr.
+     * Debug messages are dropped so they don't drown tool output.
+     */
+    class Logger {
+    private:
+        std::string m_name;
+
+        static void format(std::ostringstream &stream, std::string_view format) {
+            stream << format;
+        }
+
+        template<typename T, typename... Args>
+        static void format(std::ostringstream &stream, std::string_view format, const T &value, const Args &...args) {
+            auto placeholder = format.find("{}");
+            if(placeholder == std::string_view::npos) {
+                stream << format;
+                return;
+            }
+            stream << format.substr(0, placeholder) << value;
+            Logger::format(stream, format.substr(placeholder + 2), args...);
+        }
+
+        template<typename... Args>
+        void print(const char *level, std::string_view format, const Args &...args) const {
+            std::ostringstream stream;
+            Logger::format(stream, format, args...);
+            std::cerr << "[" << m_name << "] " << level << ": " << stream.str() << std::endl;
+        }
+
+    public:
+        template<typename... Args>
+        void debug(std::string_view, const Args &...) const {}
+
+        template<typename... Args>
+        void info(std::string_view format, const Args &...args) const {
+            print("info", format, args...);
+        }
+
+        template<typename... Args>
+        void warning(std::string_view format, const Args &...args) const {
+            print("warning", format, args...);
+        }
+
+        template<typename... Args>
+        void error(std::string_view format, const Args &...args) const {
+            print("error", format, args...);
+        }
+
+        Logger(std::string name) : m_name(std::move(name)) {}
+    };
+}
+
+#endif
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__MATH_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__MATH_HPP
+
+#include <cmath>
+#include "engine/data_types.hpp"
+
+namespace Balltze::Math {
+    struct QuadraticBezier {
+        Engine::Point2D p1;
+        Engine::Point2D p2;
+        Engine::Point2D p3;
+
+        Engine::Point2D get_point(float t) const noexcept {
+            float u = 1.0f - t;
+            return {
+                u * u * p1.x + 2.0f * u * t * p2.x + t * t * p3.x,
+                u * u * p1.y + 2.0f * u * t * p2.y + t * t * p3.y
+            };
+        }
+
+        static QuadraticBezier linear() noexcept {
+            return { { 0.0f, 0.0f }, { 0.5f, 0.5f }, { 1.0f, 1.0f } };
+        }
+
+        static QuadraticBezier flat() noexcept {
+            return { { 0.0f, 0.0f }, { 0.5f, 0.0f }, { 1.0f, 0.0f } };
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__BALLTZE__PLUGIN_HPP
+#define RACCOON__TOOLS__HOST__BALLTZE__PLUGIN_HPP
+
+#include <filesystem>
+
+namespace Balltze {
+    enum BalltzeSide {
+        BALLTZE_SIDE_CLIENT,
+        BALLTZE_SIDE_DEDICATED_SERVER
+    };
+
+    std::filesystem::path get_plugin_path() noexcept;
+    BalltzeSide get_balltze_side() noexcept;
+}
+
+#endif
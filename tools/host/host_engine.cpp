@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <array>
+#include <deque>
+#include <balltze/command.hpp>
+#include <balltze/engine/user_interface.hpp>
+#include <balltze/plugin.hpp>
+#include "host_engine.hpp"
+
+namespace Raccoon::Host {
+    using namespace Balltze::Engine;
+
+    struct HostTag {
+        std::string path;
+        Tag tag;
+    };
+
+    static std::deque<HostTag> tags;
+    static std::array<Player, 16> players = {};
+    static bool team_game = false;
+    static HostEngineStats stats;
+
+    TagHandle add_tag(std::string path, TagClassInt tag_class, void *data) {
+        TagHandle handle(static_cast<std::uint32_t>(tags.size()));
+        auto &host_tag = tags.emplace_back(HostTag { std::move(path), {} });
+        host_tag.tag = { tag_class, handle, host_tag.path.data(), reinterpret_cast<std::byte *>(data) };
+        return handle;
+    }
+
+    void clear_tags() noexcept {
+        tags.clear();
+    }
+
+    Player &player(std::size_t index) noexcept {
+        return players[index];
+    }
+
+    void set_team_game(bool value) noexcept {
+        team_game = value;
+    }
+
+    HostEngineStats &engine_stats() noexcept {
+        return stats;
+    }
+}
+
+namespace Balltze::Engine {
+    using namespace Raccoon::Host;
+
+    Tag *get_tag(std::string path, TagClassInt tag_class) noexcept {
+        stats.tag_lookups++;
+        for(auto &host_tag : tags) {
+            if(host_tag.tag.primary_class == tag_class && host_tag.path == path) {
+                return &host_tag.tag;
+            }
+        }
+        return nullptr;
+    }
+
+    Tag *get_tag(TagHandle handle) noexcept {
+        return handle.value < tags.size() ? &tags[handle.value].tag : nullptr;
+    }
+
+    Player *PlayerTable::get_player(PlayerHandle handle) noexcept {
+        return !handle.is_null() && handle.index < players.size() ? &players[handle.index] : nullptr;
+    }
+
+    Player *PlayerTable::get_client_player() noexcept {
+        return &players[0];
+    }
+
+    PlayerTable &get_player_table() noexcept {
+        static PlayerTable table;
+        return table;
+    }
+
+    bool network_game_current_game_is_team() noexcept {
+        return team_game;
+    }
+
+    void draw_bitmap_in_rect(TagDefinitions::BitmapData *, Rectangle2D, ColorARGBInt) noexcept {
+        stats.draw_calls++;
+    }
+
+    void load_bitmap_data_texture(TagDefinitions::BitmapData *, bool, bool) noexcept {
+        stats.texture_loads++;
+    }
+
+    void free_bitmap_data_texture(TagDefinitions::BitmapData *) noexcept {
+        stats.texture_frees++;
+    }
+
+    void play_sound(TagHandle tag) noexcept {
+        stats.sounds_played++;
+        stats.last_played_sound = tag;
+    }
+
+    std::chrono::milliseconds get_sound_permutation_samples_duration(TagDefinitions::SoundPermutation *permutation) noexcept {
+        return std::chrono::milliseconds(permutation->samples_duration_ms);
+    }
+}
+
+namespace Balltze {
+    std::filesystem::path get_plugin_path() noexcept {
+        return std::filesystem::current_path();
+    }
+
+    BalltzeSide get_balltze_side() noexcept {
+        return BALLTZE_SIDE_CLIENT;
+    }
+
+    bool register_command(const char *, const char *, const char *, std::optional<const char *>, CommandFunction, bool, std::size_t, std::size_t, bool, bool) {
+        return true;
+    }
+}
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#ifndef RACCOON__TOOLS__HOST__HOST_ENGINE_HPP
+#define RACCOON__TOOLS__HOST__HOST_ENGINE_HPP
+
+#include <cstddef>
+#include <string>
+#include <balltze/engine/data_types.hpp>
+
+namespace Raccoon::Host {
+    struct HostEngineStats {
+        std::size_t draw_calls = 0;
+        std::size_t texture_loads = 0;
+        std::size_t texture_frees = 0;
+        std::size_t sounds_played = 0;
+        std::size_t tag_lookups = 0;
+        Balltze::Engine::TagHandle last_played_sound;
+    };
+
+    /**
+     * Register a tag for the stand-in engine to hand out; its data must outlive the registration
+     */
+    Balltze::Engine::TagHandle add_tag(std::string path, Balltze::Engine::TagClassInt tag_class, void *data);
+    void clear_tags() noexcept;
+
+    Balltze::Engine::Player &player(std::size_t index) noexcept;
+    void set_team_game(bool team_game) noexcept;
+    HostEngineStats &engine_stats() noexcept;
+}
+
+#endif
@@ -0,0 +1,7 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "../../src/logger.hpp"
+
+namespace Raccoon {
+    Balltze::Logger logger("Raccoon");
+}
@@ -0,0 +1,438 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <balltze/engine/tag_definitions/bitmap.hpp>
+#include <balltze/engine/tag_definitions/sound.hpp>
+#include <balltze/engine/tag_definitions/tag_collection.hpp>
+#include "../src/medals/atlas.hpp"
+#include "../src/medals/h4.hpp"
+#include "../src/medals/medals.hpp"
+#include "host/host_engine.hpp"
+
+using namespace Raccoon::Medals;
+using namespace Balltze;
+namespace Host = Raccoon::Host;
+
+/**
+ * Times the medal hot paths against the stand-in engine and prints the results as JSON
+ */
+namespace {
+    /** Atlas packing that fills less of its pages than this fails the run */
+    constexpr float min_atlas_occupancy = 0.85f;
+
+    struct BenchmarkResult {
+        std::string name;
+        std::size_t iterations;
+        double total_ms;
+    };
+
+    template<typename Function>
+    BenchmarkResult run_benchmark(const char *name, std::size_t iterations, Function &&function) {
+        for(std::size_t i = 0; i < iterations / 10; i++) {
+            function(i);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < iterations; i++) {
+            function(i);
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return { name, iterations, elapsed };
+    }
+
+    /**
+     * Tags of the H4 medals style, laid out like the engine would load them
+     */
+    class HostH4Tags {
+    private:
+        static constexpr std::size_t flipbook_frames = 16;
+
+        std::deque<std::vector<Engine::TagDefinitions::BitmapData>> m_bitmap_data;
+        std::deque<Engine::TagDefinitions::Bitmap> m_bitmaps;
+        std::deque<Engine::TagDefinitions::SoundPermutation> m_permutations;
+        std::deque<Engine::TagDefinitions::SoundPitchRange> m_pitch_ranges;
+        std::deque<Engine::TagDefinitions::Sound> m_sounds;
+        std::vector<Engine::TagDefinitions::TagCollectionTag> m_collection_tags;
+        Engine::TagDefinitions::TagCollection m_collection = {};
+
+    public:
+        HostH4Tags() {
+            for(auto &[name, width, height, fps, tier, bitmap_path, sound_path] : h4_medals) {
+                auto &frames = m_bitmap_data.emplace_back(fps > 0 ? flipbook_frames : 1);
+                for(auto &frame : frames) {
+                    frame = { width, height, static_cast<std::uint32_t>(width * height * 4) };
+                }
+                auto &bitmap = m_bitmaps.emplace_back();
+                bitmap.bitmap_data = { static_cast<std::uint32_t>(frames.size()), frames.data(), nullptr };
+                auto handle = Host::add_tag(bitmap_path, Engine::TAG_CLASS_BITMAP, &bitmap);
+                m_collection_tags.push_back({ { Engine::TAG_CLASS_BITMAP, bitmap_path, std::strlen(bitmap_path), handle } });
+
+                if(sound_path) {
+                    auto &permutation = m_permutations.emplace_back();
+                    permutation.samples_duration_ms = 1200;
+                    auto &pitch_range = m_pitch_ranges.emplace_back();
+                    pitch_range.permutations = { 1, &permutation, nullptr };
+                    pitch_range.actual_permutation_count = 1;
+                    auto &sound = m_sounds.emplace_back();
+                    sound.pitch_ranges = { 1, &pitch_range, nullptr };
+                    auto handle = Host::add_tag(sound_path, Engine::TAG_CLASS_SOUND, &sound);
+                    m_collection_tags.push_back({ { Engine::TAG_CLASS_SOUND, sound_path, std::strlen(sound_path), handle } });
+                }
+            }
+            m_collection.tags = { static_cast<std::uint32_t>(m_collection_tags.size()), m_collection_tags.data(), nullptr };
+            Host::add_tag(h4_medals_tag_collection, Engine::TAG_CLASS_TAG_COLLECTION, &m_collection);
+        }
+
+        ~HostH4Tags() {
+            Host::clear_tags();
+        }
+    };
+
+    /**
+     * Starts sounds the way the engine does: play, then report the permutation being played
+     */
+    void dispatch_played_sounds(std::size_t &sounds_played) {
+        auto &stats = Host::engine_stats();
+        while(sounds_played < stats.sounds_played) {
+            sounds_played++;
+            auto *sound = reinterpret_cast<Engine::TagDefinitions::Sound *>(Engine::get_tag(stats.last_played_sound)->data);
+            Event::SoundPlaybackEvent event(Event::EVENT_TIME_AFTER, { sound, sound->pitch_ranges.elements[0].permutations.elements });
+            event.dispatch();
+        }
+    }
+
+    void write_json(std::FILE *file, const std::vector<BenchmarkResult> &results) {
+        std::fprintf(file, "{\n  \"benchmarks\": [\n");
+        for(std::size_t i = 0; i < results.size(); i++) {
+            auto &[name, iterations, total_ms] = results[i];
+            std::fprintf(file, "    { \"name\": \"%s\", \"iterations\": %zu, \"total_ms\": %.3f, \"ns_per_op\": %.1f }%s\n", name.c_str(), iterations, total_ms, total_ms * 1e6 / iterations, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+    }
+}
+
+int main(int argc, const char **argv) {
+    const char *output_path = nullptr;
+    std::size_t scale = 1;
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = std::max(1, std::atoi(argv[++i]));
+        }
+        else {
+            std::fprintf(stderr, "Usage: %s [--output <json file>] [--scale <iterations multiplier>]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    HostH4Tags tags;
+    TimePoint now = {};
+    Clock clock;
+    clock.set_source([&now]() {
+        return now;
+    });
+
+    std::vector<BenchmarkResult> results;
+    bool checks_failed = false;
+
+    {
+        MedalSequence sequence(h4_medal_keyframes);
+        MedalSequence::Cursor cursor;
+        float sink = 0.0f;
+        results.push_back(run_benchmark("sequence_get_state_at", 200000 * scale, [&](std::size_t i) {
+            sink += sequence.get_state_at(std::chrono::milliseconds(i % 2200)).scale;
+        }));
+        results.push_back(run_benchmark("sequence_get_state_at_cursor", 200000 * scale, [&](std::size_t i) {
+            sink += sequence.get_state_at(std::chrono::milliseconds(i % 2200), cursor).scale;
+        }));
+        if(sink == 0.0f) {
+            std::fprintf(stderr, "Unexpected sequence output\n");
+        }
+    }
+
+    {
+        // The batched easing has to match the scalar one it replaces
+        const Easing easings[] = { Easing::linear(), Easing(0.0f, 0.0f, 0.2f, 0.9f, 1.0f, 1.0f), Easing(0.0f, 0.0f, 0.8f, 0.1f, 1.0f, 1.0f) };
+        std::vector<float> times(1001);
+        std::vector<float> values(times.size());
+        for(std::size_t i = 0; i < times.size(); i++) {
+            times[i] = -0.1f + 1.2f * i / (times.size() - 1);
+        }
+        for(auto &easing : easings) {
+            easing.evaluate(times.data(), values.data(), times.size());
+            for(std::size_t i = 0; i < times.size(); i++) {
+                if(std::abs(values[i] - easing.evaluate(times[i])) > 1e-6f) {
+                    std::fprintf(stderr, "Batched easing differs from the scalar one at %f: %f, expected %f\n", times[i], values[i], easing.evaluate(times[i]));
+                    checks_failed = true;
+                    break;
+                }
+            }
+        }
+        results.push_back(run_benchmark("easing_evaluate_batch", 20000 * scale, [&](std::size_t) {
+            easings[1].evaluate(times.data(), values.data(), times.size());
+        }));
+    }
+
+    {
+        // Sequences that aren't baked go through the batched easing; check them against one get_state_at per render
+        MedalSequence sequence(h4_medal_keyframes);
+        constexpr std::size_t renders = RenderQueue::max_renders_capacity;
+        std::array<MedalSequence::Cursor, renders> batch_cursors = {};
+        std::array<MedalSequence::Cursor, renders> cursors = {};
+        MedalStateBatch batch;
+        for(long time = 0; time <= sequence.duration() + 100 && !checks_failed; time += 3) {
+            batch.clear();
+            for(std::size_t i = 0; i < renders; i++) {
+                batch.push(std::chrono::milliseconds(time - static_cast<long>(i) * 37), &batch_cursors[i]);
+            }
+            sequence.get_states_at(batch);
+            for(std::size_t i = 0; i < renders; i++) {
+                auto expected = sequence.get_state_at(std::chrono::milliseconds(batch.elapsed[i]), cursors[i]);
+                auto state = batch.state(i);
+                auto differs = std::abs(state.position.x - expected.position.x) > 1e-4f || std::abs(state.position.y - expected.position.y) > 1e-4f || std::abs(state.scale - expected.scale) > 1e-4f || std::abs(state.rotation - expected.rotation) > 1e-4f;
+                if(differs || state.color_mask.alpha != expected.color_mask.alpha || state.sequence_finished != expected.sequence_finished) {
+                    std::fprintf(stderr, "Batched sequence state differs from get_state_at at %ld ms\n", static_cast<long>(batch.elapsed[i]));
+                    checks_failed = true;
+                    break;
+                }
+            }
+        }
+
+        results.push_back(run_benchmark("sequence_get_states_at_exact_batch", 50000 * scale, [&](std::size_t i) {
+            batch.clear();
+            for(std::size_t r = 0; r < renders; r++) {
+                batch.push(std::chrono::milliseconds((i * 16 + r * 37) % 2200), &batch_cursors[r]);
+            }
+            sequence.get_states_at(batch);
+        }));
+    }
+
+    {
+        // Pack the H4 frames the way pack_medals_atlas does; they all fit on a single page
+        std::vector<std::pair<std::uint16_t, std::uint16_t>> frames;
+        for(auto &medal : get_h4_medals()) {
+            for(auto *bitmap : medal.bitmaps()) {
+                frames.emplace_back(bitmap->width, bitmap->height);
+            }
+        }
+        std::stable_sort(frames.begin(), frames.end(), [](auto &a, auto &b) {
+            return a.second > b.second;
+        });
+
+        AtlasPacker packer(2048, 2048);
+        auto pack_frames = [&]() {
+            packer.clear();
+            for(auto &[width, height] : frames) {
+                if(!packer.insert(width, height)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if(!pack_frames() || packer.pages_count() != 1) {
+            std::fprintf(stderr, "H4 frames need %zu atlas pages, expected one\n", packer.pages_count());
+            checks_failed = true;
+        }
+        results.push_back(run_benchmark("atlas_pack_h4_frames", 2000 * scale, [&](std::size_t) {
+            pack_frames();
+        }));
+
+        // Enough mixed sizes sorted like the H4 frames to fill many pages, so occupancy measures the packing
+        std::vector<std::pair<std::uint16_t, std::uint16_t>> rectangles;
+        std::uint32_t seed = 1;
+        auto next_size = [&seed]() {
+            seed = seed * 1664525 + 1013904223;
+            return static_cast<std::uint16_t>(16 + (seed >> 16) % 241);
+        };
+        for(std::size_t i = 0; i < 1024; i++) {
+            auto width = next_size();
+            rectangles.emplace_back(width, next_size());
+        }
+        std::stable_sort(rectangles.begin(), rectangles.end(), [](auto &a, auto &b) {
+            return a.second > b.second;
+        });
+
+        AtlasPacker mixed_packer(1024, 1024);
+        auto pack_rectangles = [&]() {
+            mixed_packer.clear();
+            for(auto &[width, height] : rectangles) {
+                mixed_packer.insert(width, height);
+            }
+        };
+        pack_rectangles();
+        if(mixed_packer.occupancy() < min_atlas_occupancy) {
+            std::fprintf(stderr, "Mixed rectangles fill %.1f%% of %zu atlas pages, expected at least %.1f%%\n", mixed_packer.occupancy() * 100, mixed_packer.pages_count(), min_atlas_occupancy * 100);
+            checks_failed = true;
+        }
+        results.push_back(run_benchmark("atlas_pack_mixed_rectangles", 200 * scale, [&](std::size_t) {
+            pack_rectangles();
+        }));
+    }
+
+    results.push_back(run_benchmark("get_h4_medals", 2000 * scale, [&](std::size_t) {
+        auto medals = get_h4_medals();
+        if(medals.size() != h4_medals.size()) {
+            std::fprintf(stderr, "Unexpected H4 medals count\n");
+        }
+    }));
+
+    {
+        auto medals = get_h4_medals();
+        const Medal *glow = nullptr;
+        for(auto &medal : medals) {
+            if(medal.name() == "glow") {
+                glow = &medal;
+            }
+        }
+
+        H4RenderQueue queue(clock);
+        RecordingSpriteBackend backend;
+        queue.set_sprite_backend(&backend);
+        queue.set_glow_sprite(const_cast<Medal *>(glow));
+        results.push_back(run_benchmark("h4_render_queue_render", 100000 * scale, [&](std::size_t i) {
+            now += std::chrono::milliseconds(16);
+            if(i % 8 == 0) {
+                queue.show_medal(&medals[i % medals.size()]);
+            }
+            backend.clear();
+            Event::UIRenderEvent event(Event::EVENT_TIME_BEFORE, {});
+            event.dispatch();
+        }));
+    }
+
+    {
+        // A full strip has to take fewer submissions than drawing every medal and glow on its own; the glows at least share one
+        auto medals = get_h4_medals();
+        Medal *glow = nullptr;
+        std::vector<const Medal *> shown;
+        for(auto &medal : medals) {
+            if(medal.name() == "glow") {
+                glow = &medal;
+            }
+            else if(shown.size() < 3) {
+                shown.push_back(&medal);
+            }
+        }
+
+        H4RenderQueue queue(clock);
+        RecordingSpriteBackend backend;
+        queue.set_sprite_backend(&backend);
+        queue.set_glow_sprite(glow);
+        for(std::size_t i = 0; i < 6; i++) {
+            queue.show_medal(shown[i % shown.size()]);
+        }
+
+        std::size_t visible_medals = 0;
+        for(std::size_t frame = 0; frame < 60 && visible_medals < 6; frame++) {
+            now += std::chrono::milliseconds(16);
+            backend.clear();
+            Event::UIRenderEvent event(Event::EVENT_TIME_BEFORE, {});
+            event.dispatch();
+            visible_medals = std::count_if(backend.quads().begin(), backend.quads().end(), [&](const SpriteQuad &quad) {
+                auto &glow_bitmaps = glow->bitmaps();
+                return std::find(glow_bitmaps.begin(), glow_bitmaps.end(), quad.texture) == glow_bitmaps.end();
+            });
+        }
+        auto submissions = backend.submissions().size();
+        if(visible_medals < 6 || submissions >= 2 * visible_medals || submissions >= backend.quads().size()) {
+            std::fprintf(stderr, "%zu visible medals and %zu sprites took %zu submissions\n", visible_medals, backend.quads().size(), submissions);
+            checks_failed = true;
+        }
+    }
+
+    {
+        MedalsHandler handler;
+        handler.set_time_source([&now]() {
+            return now;
+        });
+        handler.set_style(STYLE_H4);
+        Host::set_team_game(true);
+        for(std::uint16_t i = 0; i < 16; i++) {
+            Host::player(i) = { static_cast<std::uint32_t>(i % 2), 0 };
+        }
+
+        auto player_handle = [](std::uint16_t index) {
+            Engine::PlayerHandle handle;
+            handle.index = index;
+            handle.id = 0xE000 + index;
+            return handle;
+        };
+
+        std::size_t sounds_played = Host::engine_stats().sounds_played;
+        results.push_back(run_benchmark("dispatch_medals", 200000 * scale, [&](std::size_t i) {
+            // A tick every other message, so kills chain into multi-kills and sprees
+            if(i % 2 == 0) {
+                now += std::chrono::milliseconds(33);
+                Event::TickEvent tick(Event::EVENT_TIME_BEFORE, { i / 2 });
+                tick.dispatch();
+            }
+            auto causer = static_cast<std::uint16_t>((i * 7) % 16);
+            auto victim = static_cast<std::uint16_t>((i * 7 + 5) % 16);
+            Event::NetworkGameHudMessageEvent event(Event::EVENT_TIME_BEFORE, { Engine::HUD_MESSAGE_LOCAL_KILLED_PLAYER, player_handle(causer), player_handle(victim), player_handle(0) });
+            event.dispatch();
+            dispatch_played_sounds(sounds_played);
+        }));
+    }
+
+    {
+        MedalAggregator aggregator;
+        aggregator.rules().compile(h4_medal_rules, [&](std::string_view name) {
+            return aggregator.resolve_medal(name);
+        });
+        results.push_back(run_benchmark("aggregate_medals", 200000 * scale, [&](std::size_t i) {
+            MedalHudRecord record;
+            record.tick = static_cast<GameTick>(i / 2);
+            record.message = MEDAL_HUD_MESSAGE_KILL;
+            record.causer = { static_cast<std::uint16_t>((i * 7) % 16), static_cast<std::uint16_t>(0xE000 + (i * 7) % 16) };
+            record.victim = { static_cast<std::uint16_t>((i * 7 + 5) % 16), static_cast<std::uint16_t>(0xE000 + (i * 7 + 5) % 16) };
+            record.causer_team = record.causer.index % 2;
+            record.victim_team = record.victim.index % 2;
+            record.team_game = true;
+            aggregator.update(record);
+        }));
+    }
+
+    {
+        SoundPlaybackQueue queue(clock);
+        std::size_t sounds_played = Host::engine_stats().sounds_played;
+        SoundId sound = SOUND_ID_NONE;
+        for(auto &definition : h4_medals) {
+            if(definition.sound_tag_path) {
+                sound = queue.add_sound(definition.sound_tag_path);
+                break;
+            }
+        }
+        queue.resolve_sounds();
+        results.push_back(run_benchmark("sound_queue_tick", 200000 * scale, [&](std::size_t i) {
+            now += std::chrono::milliseconds(33);
+            if(i % 16 == 0) {
+                queue.enqueue_sound(sound);
+            }
+            Event::TickEvent tick(Event::EVENT_TIME_AFTER, { i });
+            tick.dispatch();
+            dispatch_played_sounds(sounds_played);
+        }));
+    }
+
+    write_json(stdout, results);
+    if(output_path) {
+        auto *file = std::fopen(output_path, "w");
+        if(!file) {
+            std::fprintf(stderr, "Failed to open %s\n", output_path);
+            return EXIT_FAILURE;
+        }
+        write_json(file, results);
+        std::fclose(file);
+    }
+    return checks_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../src/medals/h4_catalog.hpp"
+#include "../src/medals/hud_log.hpp"
+
+using namespace Raccoon::Medals;
+
+/**
+ * Replays recorded HUD message logs through the medal dispatch and rules, printing the
+ * medals the local player would have been shown and how fast the stream was evaluated.
+ */
+int main(int argc, const char **argv) {
+    const char *rules_path = nullptr;
+    bool quiet = false;
+    std::vector<const char *> logs;
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "--rules") == 0 && i + 1 < argc) {
+            rules_path = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        }
+        else {
+            logs.push_back(argv[i]);
+        }
+    }
+
+    if(logs.empty()) {
+        std::fprintf(stderr, "Usage: %s [--rules <rules file>] [--quiet] <log>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Medals named by the rules get IDs in the order they are first seen
+    std::vector<std::string> medal_names;
+    auto resolve_medal = [&](std::string_view name) -> MedalId {
+        for(std::size_t i = 0; i < medal_names.size(); i++) {
+            if(medal_names[i] == name) {
+                return static_cast<MedalId>(i);
+            }
+        }
+        medal_names.emplace_back(name);
+        return static_cast<MedalId>(medal_names.size() - 1);
+    };
+
+    MedalRuleSet rules;
+    if(rules_path) {
+        std::ifstream rules_file(rules_path);
+        if(!rules_file || !rules.load(rules_file, resolve_medal)) {
+            std::fprintf(stderr, "Failed to load rules from %s\n", rules_path);
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        rules.compile(h4_medal_rules, resolve_medal);
+    }
+
+    std::vector<MedalHudRecord> records;
+    std::vector<std::size_t> match_starts;
+    for(auto *path : logs) {
+        MedalHudLogReader reader;
+        if(!reader.open(path)) {
+            std::fprintf(stderr, "%s is not a HUD message log\n", path);
+            return EXIT_FAILURE;
+        }
+        match_starts.push_back(records.size());
+        MedalHudRecord record;
+        while(reader.read(record)) {
+            records.push_back(record);
+        }
+    }
+    match_starts.push_back(records.size());
+
+    MedalDispatcher dispatcher;
+    std::vector<std::size_t> medal_counts(medal_names.size());
+    std::size_t medals_shown = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t match = 0; match + 1 < match_starts.size(); match++) {
+        dispatcher.reset();
+        if(!quiet) {
+            std::printf("# %s\n", logs[match]);
+        }
+        for(auto i = match_starts[match]; i < match_starts[match + 1]; i++) {
+            auto &record = records[i];
+            MedalRuleResults results;
+            dispatcher.dispatch(record, rules, results, true);
+            for(std::size_t j = 0; j < results.count; j++) {
+                auto medal = results.medals[j];
+                medal_counts[medal]++;
+                medals_shown++;
+                if(!quiet) {
+                    std::printf("%u %s\n", record.tick, medal_names[medal].c_str());
+                }
+            }
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("# %zu matches, %zu messages, %zu medals in %.3f ms (%.0f messages/s)\n", logs.size(), records.size(), medals_shown, elapsed * 1000.0, elapsed > 0 ? records.size() / elapsed : 0.0);
+    for(std::size_t i = 0; i < medal_names.size(); i++) {
+        if(medal_counts[i] > 0) {
+            std::printf("#   %s: %zu\n", medal_names[i].c_str(), medal_counts[i]);
+        }
+    }
+    return EXIT_SUCCESS;
+}